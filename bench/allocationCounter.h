@@ -0,0 +1,22 @@
+#ifndef BENCH_ALLOCATION_COUNTER_H_
+#define BENCH_ALLOCATION_COUNTER_H_
+
+/*
+ * Count of heap allocations done by the benchmarked code
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <cstdint>
+
+namespace AllocationCounter {
+    /**
+     * Number of calls to the global operator new since the start of the process
+     * @return The number of allocations
+    */
+    uint64_t count();
+}
+
+#endif  // BENCH_ALLOCATION_COUNTER_H_
@@ -0,0 +1,46 @@
+#include "configOperation.h"
+#include "workloadGenerator.h"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+    /**
+     * exchanged_data with range(0) datapoints, one third of them being outputs of an "or" between two of the others
+     */
+    std::string generateConfig(benchmark::State& state) {
+        std::size_t outputCount = static_cast<std::size_t>(state.range(0)) / 3;
+        auto operations = WorkloadGenerator::pairwiseOperations(outputCount);
+        return WorkloadGenerator::generateExchangedData(static_cast<std::size_t>(state.range(0)), operations, "SpsTyp");
+    }
+}
+
+/**
+ * Import of a configuration from scratch
+ */
+static void BM_ImportExchangedData(benchmark::State& state) {
+    std::string exchangedData = generateConfig(state);
+    for (auto _ : state) {
+        ConfigOperation config;
+        config.importExchangedData(exchangedData);
+        benchmark::DoNotOptimize(config.getCompiledOperationCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * exchangedData.size()));
+}
+BENCHMARK(BM_ImportExchangedData)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Import of an unchanged configuration on top of the running one, as done on reconfigure
+ */
+static void BM_ReimportExchangedData(benchmark::State& state) {
+    std::string exchangedData = generateConfig(state);
+    ConfigOperation previous;
+    previous.importExchangedData(exchangedData);
+    for (auto _ : state) {
+        ConfigOperation config;
+        config.importExchangedData(exchangedData, &previous);
+        benchmark::DoNotOptimize(config.getCompiledOperationCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReimportExchangedData)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,172 @@
+#include "allocationCounter.h"
+#include "workloadGenerator.h"
+
+#include <benchmark/benchmark.h>
+#include <filter.h>
+#include <reading_set.h>
+
+#include <memory>
+
+extern "C" {
+    PLUGIN_HANDLE plugin_init(ConfigCategory* config,
+                          OUTPUT_HANDLE *outHandle,
+                          OUTPUT_STREAM output);
+
+    void plugin_shutdown(PLUGIN_HANDLE handle);
+    void plugin_reconfigure(PLUGIN_HANDLE handle, const std::string& newConfig);
+    void plugin_ingest(PLUGIN_HANDLE handle, READINGSET *readingSet);
+};
+
+namespace {
+    void discardOutput(OUTPUT_HANDLE *handle, READINGSET *readingSet) {
+        benchmark::DoNotOptimize(readingSet);
+    }
+
+    /**
+     * Plugin instance configured with the given operations, and batches of input readings to send to it
+     */
+    class IngestWorkload {
+    public:
+        IngestWorkload(const std::vector<WorkloadGenerator::OperationSpec>& operations, const std::string& pivotType,
+                       const std::string& optionsConfig = ""):
+            m_pivotType(pivotType)
+        {
+            m_handle = plugin_init(nullptr, nullptr, discardOutput);
+            std::string exchangedData = WorkloadGenerator::generateExchangedData(WorkloadGenerator::pointCount(operations), operations, pivotType);
+            plugin_reconfigure(m_handle, WorkloadGenerator::generatePluginConfig(exchangedData));
+            if (!optionsConfig.empty()) {
+                plugin_reconfigure(m_handle, optionsConfig);
+            }
+        }
+
+        ~IngestWorkload() {
+            plugin_shutdown(m_handle);
+        }
+
+        /**
+         * Add one reading to the batches, its value alternates from one batch to the next
+         *
+         * @param pointIndex : Index of the datapoint sending the reading
+         */
+        void addReading(std::size_t pointIndex) {
+            for (int value = 0 ; value <= 1 ; value++) {
+                std::string json = WorkloadGenerator::generatePivotJson(m_pivotType, WorkloadGenerator::pivotId(pointIndex), value,
+                                                                        1669714181, 9529451);
+                std::vector<Datapoint*> *datapoints = m_parser.parseJson(json);
+                m_readings[value].emplace_back(new Reading(WorkloadGenerator::label(pointIndex), *datapoints));
+                delete datapoints;
+            }
+        }
+
+        /**
+         * Send one batch of readings to the plugin, only the call to plugin_ingest is timed
+         *
+         * @param state : Benchmark state
+         * @param batchIndex : Index of the batch, used to alternate the values
+         * @return Number of allocations done during ingest
+         */
+        uint64_t ingestBatch(benchmark::State& state, std::size_t batchIndex) {
+            state.PauseTiming();
+            std::vector<Reading*> *readings = new std::vector<Reading*>;
+            readings->reserve(m_readings[batchIndex % 2].size());
+            for (const auto& reading : m_readings[batchIndex % 2]) {
+                readings->push_back(new Reading(*reading));
+            }
+            std::unique_ptr<ReadingSet> readingSet(new ReadingSet(readings));
+            delete readings;
+            uint64_t allocationsBefore = AllocationCounter::count();
+            state.ResumeTiming();
+
+            plugin_ingest(m_handle, readingSet.get());
+
+            state.PauseTiming();
+            uint64_t allocations = AllocationCounter::count() - allocationsBefore;
+            readingSet.reset();
+            state.ResumeTiming();
+            return allocations;
+        }
+
+        std::size_t batchSize() const { return m_readings[0].size(); }
+
+    private:
+        PLUGIN_HANDLE m_handle = nullptr;
+        std::string m_pivotType;
+        DatapointValue m_parserValue{""};
+        Datapoint m_parser{"parser", m_parserValue};
+        std::vector<std::unique_ptr<Reading>> m_readings[2];
+    };
+
+    void runIngest(benchmark::State& state, IngestWorkload& workload) {
+        uint64_t allocations = 0;
+        std::size_t batchIndex = 0;
+        for (auto _ : state) {
+            allocations += workload.ingestBatch(state, batchIndex++);
+        }
+        int64_t readingCount = static_cast<int64_t>(state.iterations() * workload.batchSize());
+        state.SetItemsProcessed(readingCount);
+        state.counters["allocs_per_reading"] = readingCount > 0 ? static_cast<double>(allocations) / readingCount : 0;
+    }
+
+    /**
+     * Throughput of readings sent to pairs of "or" operations, each input feeding a single output
+     */
+    void ingestPairwise(benchmark::State& state, const std::string& pivotType) {
+        std::size_t outputCount = static_cast<std::size_t>(state.range(0));
+        IngestWorkload workload(WorkloadGenerator::pairwiseOperations(outputCount), pivotType);
+        for (std::size_t i = 0 ; i < 2 * outputCount ; i++) {
+            workload.addReading(outputCount + i);
+        }
+        runIngest(state, workload);
+    }
+}
+
+static void BM_IngestSps(benchmark::State& state) {
+    ingestPairwise(state, "SpsTyp");
+}
+BENCHMARK(BM_IngestSps)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+static void BM_IngestDps(benchmark::State& state) {
+    ingestPairwise(state, "DpsTyp");
+}
+BENCHMARK(BM_IngestDps)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+/**
+ * One input feeding range(0) outputs, batches of 100 readings of this input
+ */
+static void BM_IngestFanOut(benchmark::State& state) {
+    std::size_t fanOut = static_cast<std::size_t>(state.range(0));
+    IngestWorkload workload(WorkloadGenerator::fanOutOperations(fanOut), "SpsTyp");
+    for (int i = 0 ; i < 100 ; i++) {
+        workload.addReading(0);
+    }
+    runIngest(state, workload);
+    state.counters["outputs_per_reading"] = static_cast<double>(fanOut);
+}
+BENCHMARK(BM_IngestFanOut)->Arg(1)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * One "or" operation with range(0) inputs, batches of 1000 readings spread over its inputs
+ */
+static void BM_IngestOperationWidth(benchmark::State& state) {
+    std::size_t width = static_cast<std::size_t>(state.range(0));
+    IngestWorkload workload(WorkloadGenerator::wideOperation(width), "SpsTyp");
+    for (std::size_t i = 0 ; i < 1000 ; i++) {
+        workload.addReading(1 + i % width);
+    }
+    runIngest(state, workload);
+}
+BENCHMARK(BM_IngestOperationWidth)->Arg(2)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Same as BM_IngestOperationWidth with coalesce_outputs enabled, a single output reading is generated per batch
+ */
+static void BM_IngestCoalescedWidth(benchmark::State& state) {
+    std::size_t width = static_cast<std::size_t>(state.range(0));
+    IngestWorkload workload(WorkloadGenerator::wideOperation(width), "SpsTyp",
+                            "{\"enable\":{\"value\":\"true\"},\"coalesce_outputs\":{\"value\":\"true\"}}");
+    for (std::size_t i = 0 ; i < 1000 ; i++) {
+        workload.addReading(1 + i % width);
+    }
+    runIngest(state, workload);
+}
+BENCHMARK(BM_IngestCoalescedWidth)->Arg(2)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,39 @@
+#ifndef INCLUDE_CACHED_DATAPOINT_LOOKUP_H_
+#define INCLUDE_CACHED_DATAPOINT_LOOKUP_H_
+
+/*
+ * Lookup of a named child datapoint remembering where it was last found
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <datapoint.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Find a child datapoint by name in a list of datapoints.
+ * Readings coming from the same south plugin always have the same layout, so the position
+ * where the name was last found is checked first and the list is only scanned on a miss.
+ * The remembered position makes lookups non-const: an instance must not be shared between threads.
+ */
+class CachedDatapointLookup {
+public:
+    explicit CachedDatapointLookup(const std::string& name): m_name(name) {}
+
+    Datapoint *find(std::vector<Datapoint*>* datapoints);
+    std::vector<Datapoint*> *findDict(std::vector<Datapoint*>* datapoints);
+    DatapointValue *findValue(std::vector<Datapoint*>* datapoints);
+
+    const std::string& getName() const { return m_name; }
+
+private:
+    std::string m_name;
+    std::size_t m_lastPosition = 0;
+};
+
+#endif  // INCLUDE_CACHED_DATAPOINT_LOOKUP_H_
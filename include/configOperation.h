@@ -11,16 +11,28 @@
  * Author: Yannick Marchetaux
  * 
  */
+#include "operationExpression.h"
+#include "outputTemplate.h"
+
 #include <rapidjson/document.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 struct OperationInfo {
     std::string operationType;
     std::vector<std::string> inputPivotIds;
+    // Parameter "k" of the operations that have one (count_ge), else 0
+    unsigned int threshold = 0;
+    // Text and bytecode of the operations defined by an expression, inputs are the pivot IDs it references
+    std::string expression;
+    std::vector<ExpressionInstruction> expressionCode;
 };
 
 struct OperationsInfo {
@@ -37,22 +49,168 @@ struct OperationInfoLookup {
         operationIndex(in_operationIndex) {}
 };
 
+/**
+ * Read-only view on a contiguous range of elements stored in one of the compiled tables
+ */
+template <typename T>
+struct ConstSpan {
+    const T* first = nullptr;
+    const T* last = nullptr;
+    ConstSpan() = default;
+    ConstSpan(const T* in_first, const T* in_last): first(in_first), last(in_last) {}
+    const T* begin() const { return first; }
+    const T* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+/**
+ * Compiled form of an output datapoint, indexed by output index
+ */
+struct CompiledOutput {
+    int pivotIndex = -1;
+    bool typeSps = true;
+    std::string pivotType;
+    std::string assetName;
+    // Prebuilt skeleton of the readings generated for this output
+    std::shared_ptr<const OutputTemplate> readingTemplate;
+    // Range of compiled operations of this output in ConfigOperation::m_compiledOperations
+    int operationBegin = 0;
+    int operationEnd = 0;
+    // The computed value is fed to the operations using this output as input, within the same ingest
+    bool chained = false;
+    // Rank of the output in the topological order of chained outputs: 0 if none of its inputs is a chained output
+    int chainLevel = 0;
+};
+
+/**
+ * Evaluator of a compiled operation, every supported operation type is compiled to one of them (see StateCounts)
+ */
+enum class OperationKernel : uint8_t {
+    // On when at least kernelParameter inputs are on: or, and, count_ge, majority
+    Threshold,
+    // On when an odd number of inputs are on, inverted when kernelParameter is 1: xor, not
+    Parity,
+    // Bytecode starting at offset kernelParameter in ConfigOperation::m_expressionCode: expression
+    Expression
+};
+
+/**
+ * Compiled form of an operation, inputs are stored as a range of dense pivot indexes in ConfigOperation::m_operationInputs
+ */
+struct CompiledOperation {
+    int outputIndex = 0;
+    int operationIndex = 0;
+    std::size_t inputBegin = 0;
+    std::size_t inputEnd = 0;
+    OperationKernel kernel = OperationKernel::Threshold;
+    uint32_t kernelParameter = 1;
+};
+
+/**
+ * Compiled form of OperationInfoLookup: operation to evaluate when a given input changes
+ */
+struct CompiledLookup {
+    int outputPivotIndex = -1;
+    int compiledOperationIndex = 0;
+    CompiledLookup() = default;
+    CompiledLookup(int in_outputPivotIndex, int in_compiledOperationIndex):
+        outputPivotIndex(in_outputPivotIndex),
+        compiledOperationIndex(in_compiledOperationIndex) {}
+};
+
+/**
+ * Differences between a configuration and the one it was imported on top of, counted in output datapoints
+ */
+struct ConfigOperationDiff {
+    std::size_t added = 0;
+    std::size_t removed = 0;
+    std::size_t modified = 0;
+    std::size_t unchanged = 0;
+};
+
 class ConfigOperation {
 public:  
-    void importExchangedData(const std::string & exchangeConfig);
+    ConfigOperation();
+    void importExchangedData(const std::string & exchangeConfig, const ConfigOperation* previous = nullptr);
     const std::vector<OperationInfoLookup>& getOperationsForInputId(const std::string& inputId) const;
 
     const std::map<std::string, OperationsInfo>& getDataOperations() const { return m_dataOperation; };
     
+    /*
+     * Access to the compiled operation graph, where every pivot ID involved in an operation is interned as a dense index
+     */
+    int getPivotIndex(const std::string& pivotId) const;
+    const std::string& getPivotId(int pivotIndex) const { return m_pivotIds[pivotIndex]; }
+    std::size_t getPivotCount() const { return m_pivotIds.size(); }
+    ConstSpan<CompiledLookup> getCompiledOperationsForInput(int inputPivotIndex) const;
+    ConstSpan<int> getOperationInputs(const CompiledOperation& operation) const;
+    const ExpressionInstruction* getExpressionCode(const CompiledOperation& operation) const { return &m_expressionCode[operation.kernelParameter]; }
+    const CompiledOperation& getCompiledOperation(int compiledOperationIndex) const { return m_compiledOperations[compiledOperationIndex]; }
+    int getChainLevel(int compiledOperationIndex) const { return m_compiledOutputs[m_compiledOperations[compiledOperationIndex].outputIndex].chainLevel; }
+    std::size_t getCompiledOperationCount() const { return m_compiledOperations.size(); }
+    const CompiledOutput& getCompiledOutput(int outputIndex) const { return m_compiledOutputs[outputIndex]; }
+    std::size_t getCompiledOutputCount() const { return m_compiledOutputs.size(); }
+    int findCompiledOperation(const std::string& outputPivotId, int operationIndex) const;
+    // Average number of readings generated by an input involved in operations, rounded up
+    std::size_t getFanOutEstimate() const { return m_fanOutEstimate; }
+    // Number of distinct chain levels of the outputs, 1 if no output is chained
+    int getChainLevelCount() const { return m_chainLevelCount; }
+    // Connected component of a pivot in the operation graph, readings of different components can be processed in parallel
+    int getComponent(int pivotIndex) const { return m_pivotComponents[pivotIndex]; }
+    std::size_t getComponentCount() const { return m_componentCount; }
+
+    /*
+     * Link with the configuration given as previous to importExchangedData, used to carry over the state of the operations
+     */
+    unsigned long getGeneration() const { return m_generation; }
+    unsigned long getBaseGeneration() const { return m_baseGeneration; }
+    const ConfigOperationDiff& getDiff() const { return m_diff; }
+    int getPreviousPivotIndex(int pivotIndex) const { return m_previousPivotIndexes[pivotIndex]; }
+    int getPreviousOperationIndex(int compiledOperationIndex) const { return m_previousOperationIndexes[compiledOperationIndex]; }
+
 private:
     void importDataPoint(const rapidjson::Value& datapoint, std::set<std::string>& foundPivotIds);
     bool importOperation(rapidjson::Value::ConstValueIterator itr, OperationInfo& out_operationInfo) const;
+    void compileOperations(const ConfigOperation* previous);
+    void compileChains();
+    bool computeChainLevels();
+    void compileComponents();
+    int internPivotId(const std::string& pivotId);
     // Stores for each output PivotID the data used to compute its operation
     std::map<std::string, OperationsInfo> m_dataOperation;
     // Lookup table to get the list of output PivotID and operation index pairs from one of the inputs PivotIDs
     std::map<std::string, std::vector<OperationInfoLookup>> m_dataOperationLookup;
-    // List of operations supported
-    const std::set<std::string> m_supportedOperationTypes = {"or"};
+
+    // Dense index of every pivot ID involved in an operation (as input or as output)
+    std::unordered_map<std::string, int> m_pivotIndexes;
+    std::vector<std::string> m_pivotIds;
+    // For each pivot index, index of its output in m_compiledOutputs (-1 if the pivot is not an output)
+    std::vector<int> m_pivotOutputIndexes;
+    std::vector<CompiledOutput> m_compiledOutputs;
+    std::vector<CompiledOperation> m_compiledOperations;
+    // Inputs of all compiled operations, each operation owning a contiguous range
+    std::vector<int> m_operationInputs;
+    // Bytecode of all the expressions, each one ended by a Return instruction
+    std::vector<ExpressionInstruction> m_expressionCode;
+    // Lookup table in CSR form: entries for input pivot index i are in [m_lookupOffsets[i], m_lookupOffsets[i+1])
+    std::vector<std::size_t> m_lookupOffsets;
+    std::vector<CompiledLookup> m_lookupEntries;
+    std::size_t m_fanOutEstimate = 0;
+    int m_chainLevelCount = 1;
+    // For each pivot index, index of its connected component
+    std::vector<int> m_pivotComponents;
+    std::size_t m_componentCount = 0;
+
+    // Unique identifier of the imported configuration
+    unsigned long m_generation = 0;
+    // Generation of the previous configuration, 0 if none was given
+    unsigned long m_baseGeneration = 0;
+    ConfigOperationDiff m_diff;
+    // For each pivot index, index of the same pivot ID in the previous configuration (-1 if new)
+    std::vector<int> m_previousPivotIndexes;
+    // For each compiled operation, index of the identical operation in the previous configuration (-1 if added or modified)
+    std::vector<int> m_previousOperationIndexes;
 };
 
 #endif  // INCLUDE_CONFIG_OPERATION_H_
\ No newline at end of file
@@ -17,11 +17,51 @@ namespace ConstantsOperation {
     constexpr const char *JsonOperations              = "operations";
     constexpr const char *JsonOperation               = "operation";
     constexpr const char *JsonInput                   = "input";
+    constexpr const char *JsonThreshold               = "k";
+    constexpr const char *JsonExpression              = "expression";
+
+    constexpr const char *OperationOr                 = "or";
+    constexpr const char *OperationAnd                = "and";
+    constexpr const char *OperationXor                = "xor";
+    constexpr const char *OperationNot                = "not";
+    constexpr const char *OperationCountGe            = "count_ge";
+    constexpr const char *OperationMajority           = "majority";
+    constexpr const char *OperationExpression         = "expression";
+
+    constexpr const char *JsonEmitPolicy                     = "emit_policy";
+    constexpr const char *ValueEmitAlways                    = "always";
+    constexpr const char *ValueEmitOnChange                  = "on-change";
+    constexpr const char *ValueEmitOnChangeOrQualityChange   = "on-change-or-quality-change";
+    constexpr const char *JsonCoalesceOutputs                = "coalesce_outputs";
+    constexpr const char *JsonQualityPolicy                  = "quality_policy";
+    constexpr const char *ValueQualityTrigger                = "trigger";
+    constexpr const char *ValueQualityWorstOf                = "worst_of";
+    constexpr const char *ValueQualityContributing           = "contributing";
+    constexpr const char *JsonTimestampPolicy                = "timestamp_policy";
+    constexpr const char *ValueTimestampTrigger              = "trigger";
+    constexpr const char *ValueTimestampMaxOfInputs          = "max_of_inputs";
+    constexpr const char *ValueTimestampMaxOfContributing    = "max_of_contributing_inputs";
+    constexpr const char *JsonRejectOutOfOrder               = "reject_out_of_order";
+    constexpr const char *JsonStateFile                      = "state_file";
+    constexpr const char *JsonStateMaxAge                    = "state_max_age";
+    constexpr const char *JsonStateFlushInterval             = "state_flush_interval";
+    constexpr const char *JsonUnknownInputPolicy             = "unknown_input_policy";
+    constexpr const char *ValueUnknownAssumeOff              = "assume_off";
+    constexpr const char *ValueUnknownWithhold               = "withhold";
+    constexpr const char *ValueUnknownQuestionable           = "questionable";
+    constexpr const char *JsonKnownInputsRatio               = "known_inputs_ratio";
+    constexpr const char *JsonWorkerThreads                  = "worker_threads";
+    constexpr const char *JsonMetricsInterval                = "metrics_interval";
+    constexpr const char *JsonMetricsAsset                   = "metrics_asset";
+    constexpr const char *ValueMetricsAsset                  = FILTER_NAME "_metrics";
+    constexpr const char *JsonOperationStats                 = "operation_stats";
 
     static const std::string JsonCdcSps     = "SpsTyp";
     static const std::string JsonCdcDps     = "DpsTyp";
 
     static const std::string KeyMessagePivotJsonRoot       = "PIVOT";
+    static const std::string KeyMetrics                    = "metrics";
+    static const std::string KeyMetricsTopOperations       = "top_operations";
     static const std::string KeyMessagePivotJsonGt         = "GTIS";
     static const std::string KeyMessagePivotJsonId         = "Identifier";
     static const std::string KeyMessagePivotJsonStVal      = "stVal";
@@ -30,6 +70,10 @@ namespace ConstantsOperation {
     static const std::string KeyMessagePivotJsonFractSec   = "FractionOfSecond";
     static const std::string KeyMessagePivotJsonQ          = "q";
     static const std::string KeyMessagePivotJsonSource     = "Source";
+    static const std::string KeyMessagePivotJsonValidity   = "Validity";
+    static const std::string KeyMessagePivotJsonDetailQuality = "DetailQuality";
+    static const std::string KeyMessagePivotJsonTest       = "test";
+    static const std::string KeyMessagePivotJsonOperatorBlocked = "operatorBlocked";
     static const std::string ValueSubstituted              = "substituted";
     static const std::string KeyMessagePivotJsonTmOrg      = "TmOrg";
 };
@@ -11,13 +11,27 @@
  * Author: Yannick Marchetaux
  * 
  */
+#include "cachedDatapointLookup.h"
 #include "configOperation.h"
+#include "filterOptions.h"
+#include "ingestMetrics.h"
+#include "inputStateTable.h"
+#include "operationStats.h"
+#include "qualityCounts.h"
+#include "stateWriter.h"
+#include "timestampMaxima.h"
+#include "workerPool.h"
 
 #include <config_category.h>
 #include <filter.h>
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class FilterOperationSp  : public FledgeFilter
 {
@@ -26,21 +40,174 @@ public:
                         ConfigCategory& filterConfig,
                         OUTPUT_HANDLE *outHandle,
                         OUTPUT_STREAM output);
+    ~FilterOperationSp();
 
     void ingest(READINGSET *readingSet);
     void reconfigure(const std::string& newConfig);
 
     void setJsonConfig(const std::string& jsonExchanged);
 
-    const ConfigOperation& getConfigOperation() const { return m_configOperation;} 
+    // The returned reference stays valid until the next reconfiguration
+    const ConfigOperation& getConfigOperation() const { return *std::atomic_load(&m_publishedConfig);} 
     Reading *generateReadingOperation(const Reading *dps, const std::string& outputPivotId, int operationIndex);
+    const IngestMetrics& getMetrics() const { return m_metrics; }
+    std::string getOperationStatsReport(std::size_t topCount = 0);
 
 private:
-    bool processReading(Reading* reading, std::vector<Reading*>& out_vectorReadingOperation);
+    /**
+     * Last reading generated for an output datapoint
+     */
+    struct EmittedOutput {
+        bool emitted = false;
+        int8_t value = 0;
+        uint16_t quality = 0;
+    };
 
+    /**
+     * Input reading involved in operations
+     */
+    struct InputReading {
+        int pivotIndex = -1;
+        int value = 0;
+        uint16_t quality = 0;
+        uint64_t timestamp = 0;
+        PivotReadingView view;
+    };
+
+    /**
+     * Operation to evaluate at the end of a coalesced reading set, with the input reading used to build its output
+     */
+    struct PendingOperation {
+        int compiledOperationIndex = 0;
+        int outputPivotIndex = -1;
+        PivotReadingView source;
+        uint64_t sourceTimestamp = 0;
+        uint16_t sourceQuality = 0;
+    };
+
+    /**
+     * State owned by a thread processing input readings, so that the workers of a parallel ingest share nothing but
+     * the counters of the operations of their own connected components. Context 0 is used by the ingest thread
+     */
+    struct IngestContext {
+        // Lookups of the PIVOT elements read on each input
+        CachedDatapointLookup pivotLookup;
+        CachedDatapointLookup gtisLookup;
+        CachedDatapointLookup identifierLookup;
+        CachedDatapointLookup spsLookup;
+        CachedDatapointLookup dpsLookup;
+        CachedDatapointLookup stValLookup;
+        CachedDatapointLookup qLookup;
+        // Operations to evaluate for the current input reading, by chain level of their output, only used with chained outputs
+        std::vector<std::vector<CompiledLookup>> chainBuckets;
+        // Inputs whose state changed since the last call to saveState, only filled when the state file is open
+        std::vector<int> changedInputs;
+        // Counters added to m_metrics at the end of each reading set
+        MetricCounts metricCounts;
+
+        IngestContext();
+    };
+
+    bool readInput(IngestContext& context, Reading* reading, InputReading& out_input);
+    bool processReading(IngestContext& context, Reading* reading, std::vector<Reading*>& out_vectorReadingOperation);
+    bool processInput(IngestContext& context, Reading* reading, const InputReading& inputReading, std::vector<Reading*>& out_vectorReadingOperation);
+    void processReadingsInParallel(std::vector<Reading*>& readings, std::vector<Reading*>& out_vectorReadingOperation);
+    void updateWorkerPool(std::size_t workerCount);
+    Reading* generateMetricsReading(std::chrono::steady_clock::time_point now);
+    bool coalesceReading(Reading* reading);
+    void addPendingOperation(const CompiledLookup& operationLookup, const PivotReadingView& source, uint64_t sourceTimestamp, uint16_t sourceQuality);
+    void generatePendingOperations(std::vector<Reading*>& out_vectorReadingOperation);
+    void scheduleOperations(IngestContext& context, int inputPivotIndex);
+    bool propagateOutput(IngestContext& context, int compiledOperationIndex, int value, const OutputAttributes& attributes, uint64_t triggerTimestamp);
+    Reading *generateReadingOperation(const PivotReadingView& input, int compiledOperationIndex, int value, const OutputAttributes& attributes);
+    OutputAttributes computeOutputAttributes(int compiledOperationIndex, int value, uint16_t triggerQuality);
+    uint64_t getTimestampMaximum(int compiledOperationIndex, int group);
+    bool isOutputChanged(int outputPivotIndex, int value, uint16_t quality) const;
+    void recordEmittedOutput(int outputPivotIndex, int value, uint16_t quality);
+    bool isOutOfOrder(const InputReading& input) const;
+    bool isOwnOutput(int inputPivotIndex) const;
+    bool hasTooManyUnknownInputs(int compiledOperationIndex) const;
+    void updateCachedValue(IngestContext& context, const InputReading& input);
+    int evaluateOperation(int compiledOperationIndex) const;
+    int measureOperation(int compiledOperationIndex);
+    void updateMeasuredValue(IngestContext& context, const InputReading& input);
+    void countOutput(IngestContext& context, int compiledOperationIndex, bool emitted);
+    std::string buildOperationStatsReport(std::size_t topCount) const;
+    std::shared_ptr<const ConfigOperation> compileJsonConfig(const std::string& jsonExchanged);
+    void refreshActiveConfig(const std::shared_ptr<const ConfigOperation>& publishedConfig);
+    void switchActiveConfig(const std::shared_ptr<const ConfigOperation>& publishedConfig);
+    void rebuildQualityCounts(bool enabled);
+    void rebuildTimestampMaxima(bool enabled);
+    void restoreState();
+    void switchStateFile(const std::string& stateFile);
+    void saveState();
+    void writeStateSnapshot();
+    PersistedInput getPersistedInput(int pivotIndex) const;
+
+    // Minimum number of journal records before the state snapshot is rewritten, the journal may also grow up to the number of pivots
+    static const std::size_t SnapshotMinJournalRecords = 4096;
+    // Minimum number of readings in a reading set for it to be processed by the worker pool, smaller ones are not worth the synchronization
+    static const std::size_t ParallelMinReadings = 512;
+    // Number of tasks given to each worker of the pool, more tasks than workers let idle workers steal the remaining ones
+    static const std::size_t TasksPerWorker = 4;
+    // Number of outputs listed in the metrics reading when operation statistics are enabled
+    static const std::size_t MetricsTopOperations = 10;
+    // Maximum number of output readings reserved for each reading of a reading set
+    static const std::size_t MaxReservedFanOut = 4;
+
+    // Protects the base class configuration (enable flag), m_options and the publication of m_publishedConfig, never held while parsing exchanged_data
     std::mutex                  m_configMutex;
-    ConfigOperation             m_configOperation;
-    std::map<std::string, int>  m_cachedValues;
+    FilterOptions               m_options;
+    // Copy of m_options taken at the start of each reading set
+    FilterOptions               m_ingestOptions;
+    // Serializes the processing of reading sets, owner of m_activeConfig and of the cached state
+    std::mutex                  m_ingestMutex;
+    // Last compiled configuration published by a reconfiguration, stored under m_configMutex with std::atomic_store,
+    // read by ingest under m_configMutex and by getConfigOperation with std::atomic_load
+    std::shared_ptr<const ConfigOperation> m_publishedConfig;
+    // Compiled configuration used by ingest, switched to the published one at the start of each reading set
+    std::shared_ptr<const ConfigOperation> m_activeConfig;
+    // Last known state of each input, indexed by the dense pivot index of the compiled configuration
+    InputStateTable             m_inputStates;
+    // Number of inputs in each state for each compiled operation, packed as described in StateCounts
+    std::vector<uint64_t>       m_stateCounts;
+    // Number of inputs never received for each compiled operation
+    std::vector<uint32_t>       m_unknownCounts;
+    // Quality masks of the inputs of each compiled operation, aggregated by input state, only maintained when m_qualityCountsEnabled
+    QualityCounts               m_qualityCounts;
+    bool                        m_qualityCountsEnabled = false;
+    // Decode the quality of the input readings, only needed by the options using the quality of the inputs
+    bool                        m_readInputQualities = false;
+    // Newest timestamps of the inputs of each compiled operation, by input state and for all the inputs, only maintained when m_timestampMaximaEnabled
+    TimestampMaxima             m_timestampMaxima;
+    bool                        m_timestampMaximaEnabled = false;
+    // Read the timestamp of the input readings, only needed by the options using the timestamp of the inputs
+    bool                        m_readInputTimestamps = false;
+    // Evaluations and outputs of each compiled operation, only updated when the operation_stats option is enabled
+    OperationStatsTable         m_operationStats;
+    // Last reading generated for each output, indexed by the dense pivot index of the compiled configuration
+    std::vector<EmittedOutput>  m_lastEmitted;
+    // Operations affected by a coalesced reading set, in the order of the first reading affecting them
+    std::vector<PendingOperation> m_pendingOperations;
+    // For each compiled operation, its index in m_pendingOperations (-1 if not affected by the current reading set)
+    std::vector<int>            m_pendingOperationIndexes;
+    // For each compiled operation, 1 if it is in one of the chain buckets of an ingest context
+    std::vector<uint8_t>        m_scheduledOperations;
+    // Snapshot and journal of the input states on disk, fed under m_ingestMutex and written by a thread of its own
+    StateWriter                 m_stateWriter;
+    // Path of the state file in use, empty if none
+    std::string                 m_stateFile;
+    // Input states read from the state file on start, applied to the pivots of the first configuration used by ingest
+    std::unordered_map<std::string, PersistedInput> m_restoredInputs;
+    bool                        m_restorePending = false;
+    // One context per worker of m_workerPool (a single one without pool), only used under m_ingestMutex
+    std::vector<std::unique_ptr<IngestContext>> m_ingestContexts;
+    // Workers processing the connected components of large reading sets in parallel, null when the worker_threads option is 0 or 1
+    std::unique_ptr<WorkerPool> m_workerPool;
+    // Counters and latency histograms of the filter, only updated with relaxed atomic operations
+    IngestMetrics               m_metrics;
+    // Time the last metrics reading was generated, epoch of the clock if none was
+    std::chrono::steady_clock::time_point m_lastMetricsTime;
 };
 
 #endif  // INCLUDE_FILTER_OPERATION_SP_H_
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef INCLUDE_FILTER_OPTIONS_H_
+#define INCLUDE_FILTER_OPTIONS_H_
+
+/*
+ * Options of the filter read from the plugin configuration (other than exchanged_data)
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "constantsOperation.h"
+
+#include <config_category.h>
+
+#include <string>
+
+/**
+ * When an output reading is generated for a computed datapoint
+ */
+enum class EmitPolicy {
+    // For every input reading involved in the operation
+    Always,
+    // Only when the computed value differs from the last one emitted
+    OnChange,
+    // When the computed value or the quality of the triggering input differs from the last one emitted
+    OnChangeOrQualityChange
+};
+
+/**
+ * Quality given to an output reading
+ */
+enum class QualityPolicy {
+    // Quality of the input reading that triggered the operation
+    Trigger,
+    // Worst quality of all the inputs of the operation
+    WorstOf,
+    // Worst quality of the inputs whose state is the result of the operation, of all the inputs for the operations
+    // whose result is not the state of some inputs (not, xor, expression)
+    Contributing
+};
+
+/**
+ * Timestamp given to an output reading
+ */
+enum class TimestampPolicy {
+    // Timestamp of the input reading that triggered the operation
+    Trigger,
+    // Newest timestamp of all the inputs of the operation
+    MaxOfInputs,
+    // Newest timestamp of the inputs whose state is the result of the operation, of all the inputs for the operations
+    // whose result is not the state of some inputs (not, xor, expression)
+    MaxOfContributingInputs
+};
+
+/**
+ * Output of an operation when too many of its inputs were never received
+ */
+enum class UnknownInputPolicy {
+    // Unknown inputs are off
+    AssumeOff,
+    // No output reading is generated
+    Withhold,
+    // The output reading is generated with a questionable validity
+    Questionable
+};
+
+/**
+ * Options of the filter, copied by ingest at the start of each reading set
+ */
+struct FilterOptions {
+    EmitPolicy emitPolicy = EmitPolicy::Always;
+    // Evaluate a whole reading set before generating at most one reading per output operation
+    bool coalesceOutputs = false;
+    QualityPolicy qualityPolicy = QualityPolicy::Trigger;
+    TimestampPolicy timestampPolicy = TimestampPolicy::Trigger;
+    // Ignore the readings of an input older than the last one received for this input
+    bool rejectOutOfOrder = false;
+    // Path of the snapshot of the input states kept on disk for warm restarts, empty to disable it (see StateStore)
+    std::string stateFile;
+    // Input states restored from stateFile whose timestamp is older than this number of seconds are ignored, 0 to keep them all
+    long stateMaxAge = 0;
+    // Milliseconds between two writes of the changes of the input states to the journal of stateFile, 0 to write them after each reading set
+    long stateFlushInterval = 1000;
+    UnknownInputPolicy unknownInputPolicy = UnknownInputPolicy::AssumeOff;
+    // Fraction of the inputs of an operation that must be known for its output not to be affected by unknownInputPolicy
+    double knownInputsRatio = 1.0;
+    // Number of threads processing the readings of independent operations in parallel, 0 or 1 to process them in the ingest thread
+    long workerThreads = 0;
+    // Number of seconds between two readings of the metrics of the filter, 0 to send none
+    long metricsInterval = 0;
+    // Asset name of the readings of the metrics
+    std::string metricsAsset = ConstantsOperation::ValueMetricsAsset;
+    // Measure the evaluations of each operation, reported with the metrics
+    bool operationStats = false;
+
+    // Upper bound of workerThreads, larger values are rejected as invalid
+    static const long MaxWorkerThreads = 256;
+
+    void importConfig(const ConfigCategory& config);
+};
+
+#endif  // INCLUDE_FILTER_OPTIONS_H_
@@ -0,0 +1,102 @@
+#ifndef INCLUDE_INGEST_METRICS_H_
+#define INCLUDE_INGEST_METRICS_H_
+
+/*
+ * Counters and latency histograms of the work done by the filter
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Datapoint;
+
+/**
+ * Counters of the readings processed by the filter
+ */
+enum class MetricCounter {
+    ReadingsIn,
+    // Readings involved in operations
+    ReadingsMatched,
+    // Readings forwarded unchanged, by reason
+    IgnoredMissingPivot,
+    IgnoredMissingGtis,
+    IgnoredMissingIdentifier,
+    IgnoredNoOperation,
+    IgnoredMissingCdc,
+    IgnoredMissingStVal,
+    IgnoredOutOfOrder,
+    // Output readings generated, including the input readings rewritten in place
+    OutputsGenerated,
+    // Outputs not generated because of the emit policy or of the unknown input policy
+    OutputsSuppressed,
+    // Input readings removed from the reading set
+    InputsDeleted,
+    Count
+};
+
+/**
+ * Histogram of durations in nanoseconds with a bounded relative error, in the manner of HDR histograms:
+ * each power of two is split in SubBucketCount linear buckets, so a recorded value is known within 1/SubBucketCount.
+ * Values are recorded with relaxed atomic increments and can be read while other threads record.
+ */
+class LatencyHistogram {
+public:
+    static const int SubBucketBits = 4;
+    static const std::size_t SubBucketCount = 1 << SubBucketBits;
+    static const std::size_t BucketCount = SubBucketCount * (64 - SubBucketBits + 1);
+
+    LatencyHistogram();
+    void record(uint64_t value);
+    uint64_t getCount() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t getMax() const { return m_max.load(std::memory_order_relaxed); }
+    uint64_t getMean() const;
+    uint64_t getValueAtPercentile(double percentile) const;
+    Datapoint* toDatapoint(const std::string& name) const;
+
+    static std::size_t getBucketIndex(uint64_t value);
+    static uint64_t getBucketUpperBound(std::size_t bucketIndex);
+
+private:
+    std::atomic<uint64_t> m_buckets[BucketCount];
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+};
+
+/**
+ * Counters local to a thread, added to IngestMetrics once per reading set so that workers never share a cache line
+ */
+struct MetricCounts {
+    uint64_t counts[static_cast<int>(MetricCounter::Count)] = {};
+
+    void add(MetricCounter counter, uint64_t value = 1) { counts[static_cast<int>(counter)] += value; }
+};
+
+/**
+ * Metrics of a filter instance since it was started
+ */
+class IngestMetrics {
+public:
+    IngestMetrics();
+    void add(MetricCounter counter, uint64_t value = 1) { m_counters[static_cast<int>(counter)].fetch_add(value, std::memory_order_relaxed); }
+    void add(MetricCounts& counts);
+    uint64_t get(MetricCounter counter) const { return m_counters[static_cast<int>(counter)].load(std::memory_order_relaxed); }
+
+    // Duration of the processing of the reading sets, excluding the next filters
+    LatencyHistogram ingestLatency;
+    // Duration of the import of the exchanged_data configuration
+    LatencyHistogram configLatency;
+
+    Datapoint* toDatapoint(const std::string& name) const;
+
+private:
+    std::atomic<uint64_t> m_counters[static_cast<int>(MetricCounter::Count)];
+};
+
+#endif  // INCLUDE_INGEST_METRICS_H_
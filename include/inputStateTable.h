@@ -0,0 +1,82 @@
+#ifndef INCLUDE_INPUT_STATE_TABLE_H_
+#define INCLUDE_INPUT_STATE_TABLE_H_
+
+/*
+ * Last known state of the inputs of the operations
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * State of every input, stored as one byte per dense pivot index of the compiled configuration.
+ * The two low bits hold the value of the input, remaining bits are kept for flags about the input.
+ * An input is unknown until its first reading is received: its value is then off, but operations can tell it apart (KnownFlag).
+ * One byte per input (rather than packed bits) keeps every update a single independent write.
+ * The quality mask (see PivotQuality) and the packed timestamp (see PivotTimestamp) of each input are stored next to it.
+ */
+class InputStateTable {
+public:
+    static const uint8_t ValueMask = 0x03;
+    static const uint8_t KnownFlag = 0x04;
+
+    void reset(std::size_t inputCount) {
+        m_states.assign(inputCount, 0);
+        m_qualities.assign(inputCount, 0);
+        m_timestamps.assign(inputCount, 0);
+    }
+    std::size_t size() const { return m_states.size(); }
+    void swap(InputStateTable& other) {
+        m_states.swap(other.m_states);
+        m_qualities.swap(other.m_qualities);
+        m_timestamps.swap(other.m_timestamps);
+    }
+    // Copy state, quality and timestamp of an input of another table
+    void copyInput(int inputIndex, const InputStateTable& other, int otherIndex) {
+        m_states[inputIndex] = other.m_states[otherIndex];
+        m_qualities[inputIndex] = other.m_qualities[otherIndex];
+        m_timestamps[inputIndex] = other.m_timestamps[otherIndex];
+    }
+
+    uint8_t getState(int inputIndex) const { return m_states[inputIndex]; }
+    void setState(int inputIndex, uint8_t state) { m_states[inputIndex] = state; }
+
+    int getValue(int inputIndex) const { return m_states[inputIndex] & ValueMask; }
+    /**
+     * Store the value of an input
+     *
+     * @param inputIndex : Dense index of the input
+     * @param value : New value (two bits)
+     * @return true if the value changed, else false
+     */
+    bool updateValue(int inputIndex, int value) {
+        uint8_t& state = m_states[inputIndex];
+        uint8_t newState = static_cast<uint8_t>((state & ~ValueMask) | (value & ValueMask));
+        if (newState == state) {
+            return false;
+        }
+        state = newState;
+        return true;
+    }
+
+    bool isKnown(int inputIndex) const { return (m_states[inputIndex] & KnownFlag) != 0; }
+    void setKnown(int inputIndex) { m_states[inputIndex] |= KnownFlag; }
+
+    uint16_t getQuality(int inputIndex) const { return m_qualities[inputIndex]; }
+    void setQuality(int inputIndex, uint16_t quality) { m_qualities[inputIndex] = quality; }
+
+    uint64_t getTimestamp(int inputIndex) const { return m_timestamps[inputIndex]; }
+    void setTimestamp(int inputIndex, uint64_t timestamp) { m_timestamps[inputIndex] = timestamp; }
+
+private:
+    std::vector<uint8_t> m_states;
+    std::vector<uint16_t> m_qualities;
+    std::vector<uint64_t> m_timestamps;
+};
+
+#endif  // INCLUDE_INPUT_STATE_TABLE_H_
@@ -0,0 +1,68 @@
+#ifndef INCLUDE_OPERATION_EXPRESSION_H_
+#define INCLUDE_OPERATION_EXPRESSION_H_
+
+/*
+ * Expressions of operations, compiled to a postfix bytecode
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "inputStateTable.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Instruction of the bytecode of an expression, executed on a stack of states (PointState)
+ */
+struct ExpressionInstruction {
+    enum Opcode : uint8_t {
+        // Push the state of the input at index operand in the inputs of the operation
+        Input,
+        Not,
+        And,
+        Or,
+        Xor,
+        // Pop argumentCount states, push the result of the comparison of the number of them on with operand
+        Count,
+        // Pop the result of the expression
+        Return
+    };
+    enum Comparison : uint8_t {
+        GreaterOrEqual,
+        Less,
+        Equal,
+        NotEqual
+    };
+    Opcode opcode = Return;
+    Comparison comparison = GreaterOrEqual;
+    uint16_t argumentCount = 0;
+    uint32_t operand = 0;
+};
+
+/**
+ * Parsing and evaluation of the "expression" of an operation, for instance "(A or B) and not C" or "count(A, B, C, D) >= 2"
+ * Grammar, from the lowest to the highest precedence:
+ *     expression := xorExpr ("or" xorExpr)*
+ *     xorExpr    := andExpr ("xor" andExpr)*
+ *     andExpr    := notExpr ("and" notExpr)*
+ *     notExpr    := "not" notExpr | primary
+ *     primary    := pivotId | "(" expression ")" | "count" "(" expression ("," expression)* ")" (">=" | ">" | "<=" | "<" | "==" | "!=") integer
+ * Operators follow the same rules as the operation types for intermediate and bad inputs: "A and B" is the "and" operation
+ * of A and B, "count(...) >= k" the "count_ge" operation.
+ */
+namespace OperationExpression {
+    // Maximum number of states on the stack while evaluating an expression
+    const int MaxStackDepth = 256;
+    // Maximum number of nested parentheses and count arguments, bounding the recursion of the parser
+    const int MaxNestingDepth = 256;
+
+    bool parse(const std::string& expression, std::vector<std::string>& out_inputPivotIds,
+               std::vector<ExpressionInstruction>& out_code, std::string& out_error);
+    int evaluate(const ExpressionInstruction* code, const int* inputPivotIndexes, const InputStateTable& inputStates);
+};
+
+#endif  // INCLUDE_OPERATION_EXPRESSION_H_
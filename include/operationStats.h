@@ -0,0 +1,94 @@
+#ifndef INCLUDE_OPERATION_STATS_H_
+#define INCLUDE_OPERATION_STATS_H_
+
+/*
+ * Statistics of the evaluations of each compiled operation
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Evaluations and outputs of a compiled operation
+ */
+struct OperationStats {
+    uint64_t evaluations = 0;
+    // Total time spent on the operation, in nanoseconds: its share of the updates of its inputs,
+    // its evaluation and the generation of its output readings
+    uint64_t processingTime = 0;
+    // Output readings generated, including the input readings rewritten in place
+    uint64_t emitted = 0;
+    // Outputs not generated because of the emit policy or of the unknown input policy
+    uint64_t suppressed = 0;
+
+    void add(const OperationStats& other) {
+        evaluations += other.evaluations;
+        processingTime += other.processingTime;
+        emitted += other.emitted;
+        suppressed += other.suppressed;
+    }
+};
+
+/**
+ * Statistics of each compiled operation, indexed like the compiled operations.
+ * Each operation belongs to a single connected component, so parallel workers never update the same entry.
+ */
+class OperationStatsTable {
+public:
+    void reset(std::size_t operationCount) { m_stats.assign(operationCount, OperationStats()); }
+    void swap(OperationStatsTable& other) { m_stats.swap(other.m_stats); }
+    void copyOperation(int operationIndex, const OperationStatsTable& other, int otherIndex) { m_stats[operationIndex] = other.m_stats[otherIndex]; }
+
+    void recordEvaluation(int operationIndex) {
+        m_stats[operationIndex].evaluations++;
+    }
+    void recordTime(int operationIndex, uint64_t duration) {
+        m_stats[operationIndex].processingTime += duration;
+    }
+    void recordOutput(int operationIndex, bool emitted) {
+        if (emitted) {
+            m_stats[operationIndex].emitted++;
+        }
+        else {
+            m_stats[operationIndex].suppressed++;
+        }
+    }
+    const OperationStats& get(int operationIndex) const { return m_stats[operationIndex]; }
+
+private:
+    std::vector<OperationStats> m_stats;
+};
+
+/**
+ * Adds the time elapsed between its construction and its destruction to the statistics of an operation.
+ * Nothing is measured without statistics table.
+ */
+class OperationTimer {
+public:
+    OperationTimer(OperationStatsTable* stats, int operationIndex): m_stats(stats), m_operationIndex(operationIndex) {
+        if (m_stats) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+    ~OperationTimer() {
+        if (m_stats) {
+            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+            m_stats->recordTime(m_operationIndex, static_cast<uint64_t>(duration.count()));
+        }
+    }
+    OperationTimer(const OperationTimer&) = delete;
+    OperationTimer& operator=(const OperationTimer&) = delete;
+
+private:
+    OperationStatsTable* m_stats;
+    int m_operationIndex;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#endif  // INCLUDE_OPERATION_STATS_H_
@@ -0,0 +1,69 @@
+#ifndef INCLUDE_OUTPUT_TEMPLATE_H_
+#define INCLUDE_OUTPUT_TEMPLATE_H_
+
+/*
+ * Prebuilt PIVOT skeleton used to generate output readings
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <datapoint.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Elements found in an input PIVOT reading, used to build the output readings
+ */
+struct PivotReadingView {
+    std::vector<Datapoint*>* pivot = nullptr;
+    std::vector<Datapoint*>* gtis = nullptr;
+    std::vector<Datapoint*>* cdc = nullptr;
+};
+
+/**
+ * Attributes of an output that replace the ones of the input it is built from
+ */
+struct OutputAttributes {
+    // Quality mask (PivotQuality) written instead of the quality of the input
+    bool replaceQuality = false;
+    uint16_t quality = 0;
+    // Packed timestamp (PivotTimestamp) written instead of the timestamp of the input
+    bool replaceTimestamp = false;
+    uint64_t timestamp = 0;
+};
+
+/**
+ * PIVOT skeleton of an output datapoint, built once at configuration time:
+ *     PIVOT -> GTIS -> { Identifier, <CDC> -> { stVal, q -> { Source } } }
+ * One skeleton is prebuilt per possible output state (PointState) so that generating an output only
+ * copies a few nodes and grafts the attributes taken from the input (quality, timestamp, ...).
+ * When the input is the output itself, its reading can instead be rewritten in place.
+ */
+class OutputTemplate {
+public:
+    OutputTemplate(const std::string& outputPivotId, const std::string& outputPivotType);
+    ~OutputTemplate();
+    OutputTemplate(const OutputTemplate&) = delete;
+    OutputTemplate& operator=(const OutputTemplate&) = delete;
+
+    Datapoint *instantiate(int value, const PivotReadingView& input, const OutputAttributes& attributes = OutputAttributes()) const;
+    bool rewrite(int value, const PivotReadingView& input, const OutputAttributes& attributes = OutputAttributes()) const;
+
+private:
+    // Position of the fixed nodes in the skeleton
+    static const std::size_t PosGtis = 0;
+    static const std::size_t PosIdentifier = 0;
+    static const std::size_t PosCdc = 1;
+    static const std::size_t PosStVal = 0;
+    static const std::size_t PosQ = 1;
+
+    std::string m_pivotType;
+    bool m_typeSps = true;
+    std::vector<Datapoint*> m_skeletons;
+};
+
+#endif  // INCLUDE_OUTPUT_TEMPLATE_H_
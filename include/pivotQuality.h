@@ -0,0 +1,45 @@
+#ifndef INCLUDE_PIVOT_QUALITY_H_
+#define INCLUDE_PIVOT_QUALITY_H_
+
+/*
+ * Compact form of the quality (q) of a PIVOT datapoint
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <datapoint.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Quality of a PIVOT datapoint packed in 16 bits, so that qualities can be stored, compared and aggregated cheaply:
+ *     bit 0    : Validity questionable
+ *     bit 1    : Validity invalid (also used for reserved)
+ *     bits 2-9 : DetailQuality flags
+ *     bit 10   : test
+ *     bit 11   : operatorBlocked
+ * Every bit is a flag, so that the worst of several qualities is the bitwise OR of their masks
+ * (invalid wins over questionable when both bits are set).
+ * q.Source is not part of the mask as it is always "substituted" on the outputs
+ */
+namespace PivotQuality {
+    const uint16_t ValidityGood = 0;
+    const uint16_t ValidityQuestionable = 0x0001;
+    const uint16_t ValidityInvalid = 0x0002;
+    const uint16_t ValidityMask = 0x0003;
+
+    const uint16_t DetailQualityShift = 2;
+    const uint16_t DetailQualityMask = 0x03fc;
+    const uint16_t TestFlag = 0x0400;
+    const uint16_t OperatorBlockedFlag = 0x0800;
+    // Number of bits used in the mask
+    const int BitCount = 12;
+
+    uint16_t encode(const std::vector<Datapoint*>* q);
+    void apply(std::vector<Datapoint*>* q, uint16_t mask);
+};
+
+#endif  // INCLUDE_PIVOT_QUALITY_H_
@@ -0,0 +1,36 @@
+#ifndef INCLUDE_PIVOT_TIMESTAMP_H_
+#define INCLUDE_PIVOT_TIMESTAMP_H_
+
+/*
+ * Compact form of the timestamp (t) of a PIVOT datapoint
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <datapoint.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Timestamp of a PIVOT datapoint packed in 64 bits: SecondSinceEpoch in the high bits and
+ * FractionOfSecond (24 bits) in the low bits, so that timestamps are compared as integers
+ */
+namespace PivotTimestamp {
+    const int FractionBits = 24;
+    const uint64_t FractionMask = (static_cast<uint64_t>(1) << FractionBits) - 1;
+
+    inline uint64_t pack(long seconds, long fraction) {
+        return (static_cast<uint64_t>(seconds) << FractionBits) | (static_cast<uint64_t>(fraction) & FractionMask);
+    }
+
+    inline long seconds(uint64_t timestamp) { return static_cast<long>(timestamp >> FractionBits); }
+    inline long fraction(uint64_t timestamp) { return static_cast<long>(timestamp & FractionMask); }
+
+    uint64_t read(std::vector<Datapoint*>* cdc);
+    void apply(std::vector<Datapoint*>* cdc, uint64_t timestamp);
+};
+
+#endif  // INCLUDE_PIVOT_TIMESTAMP_H_
@@ -0,0 +1,89 @@
+#ifndef INCLUDE_POINT_STATE_H_
+#define INCLUDE_POINT_STATE_H_
+
+/*
+ * States of the status points and count of the inputs of an operation in each state
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <cstdint>
+#include <string>
+
+/**
+ * State of a status point, stored on two bits. SPS only use StateOff and StateOn
+ */
+namespace PointState {
+    const int StateOff = 0;
+    const int StateOn = 1;
+    const int StateIntermediate = 2;
+    const int StateBad = 3;
+    const int StateCount = 4;
+
+    int decodeDps(const std::string& stVal);
+    const std::string& encodeDps(int state);
+};
+
+/**
+ * Number of inputs of an operation in each state, packed in one 64-bit word of three 21-bit fields
+ * (on, intermediate, bad; off is implicit). A change of input state is a single addition and
+ * evaluating an operation is a few comparisons on the fields of the word, without branches.
+ * An operation can have at most 2^21 - 1 inputs, operations with more are rejected when the configuration is imported.
+ */
+namespace StateCounts {
+    const int FieldBits = 21;
+    const uint64_t FieldMask = (static_cast<uint64_t>(1) << FieldBits) - 1;
+    const uint64_t OnMask = FieldMask;
+    const uint64_t IntermediateMask = FieldMask << FieldBits;
+    const uint64_t BadMask = FieldMask << (2 * FieldBits);
+
+    /**
+     * Value to add to the counts of an operation for one input in the given state
+     */
+    inline uint64_t unit(int state) {
+        return state == PointState::StateOff ? 0 : static_cast<uint64_t>(1) << ((state - 1) * FieldBits);
+    }
+
+    /**
+     * Number of inputs in the given state, off is not counted
+     */
+    inline uint64_t count(uint64_t counts, int state) {
+        return state == PointState::StateOff ? 0 : (counts >> ((state - 1) * FieldBits)) & FieldMask;
+    }
+
+    /**
+     * Result of a threshold operation: on if at least threshold inputs are on. Else the result is the state
+     * the operation could reach if the unknown inputs were on: bad if counting the bad inputs reaches the threshold,
+     * else intermediate if counting the intermediate inputs as well reaches it, else off.
+     * "or" is a threshold of 1, "and" a threshold of the number of inputs.
+     */
+    inline int evaluateThreshold(uint64_t counts, uint32_t threshold) {
+        // Each test implies the following ones, so that only four of the eight indexes can be reached
+        static const int8_t results[8] = {
+            PointState::StateOff, PointState::StateIntermediate, PointState::StateOff, PointState::StateBad,
+            PointState::StateOff, PointState::StateOff, PointState::StateOff, PointState::StateOn
+        };
+        uint64_t on = counts & FieldMask;
+        uint64_t bad = (counts >> (2 * FieldBits)) & FieldMask;
+        uint64_t intermediate = (counts >> FieldBits) & FieldMask;
+        int index = (static_cast<int>(on >= threshold) << 2) | (static_cast<int>(on + bad >= threshold) << 1)
+                    | static_cast<int>(on + bad + intermediate >= threshold);
+        return results[index];
+    }
+
+    /**
+     * Result of a parity operation: bad if any input is bad, else intermediate if any input is intermediate,
+     * else on if the number of inputs on is odd (even if invert is 1).
+     * "xor" is a parity, "not" an inverted parity of a single input.
+     */
+    inline int evaluateParity(uint64_t counts, uint32_t invert) {
+        int parity = static_cast<int>((counts ^ invert) & 1);
+        const int results[4] = {parity, PointState::StateIntermediate, PointState::StateBad, PointState::StateBad};
+        int index = (static_cast<int>((counts & BadMask) != 0) << 1) | static_cast<int>((counts & IntermediateMask) != 0);
+        return results[index];
+    }
+};
+
+#endif  // INCLUDE_POINT_STATE_H_
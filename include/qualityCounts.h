@@ -0,0 +1,44 @@
+#ifndef INCLUDE_QUALITY_COUNTS_H_
+#define INCLUDE_QUALITY_COUNTS_H_
+
+/*
+ * Incremental aggregation of the qualities of the inputs of the operations
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "pivotQuality.h"
+#include "pointState.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * For each compiled operation and each input state, number of inputs having each bit of their quality mask set.
+ * The OR of the quality masks of the inputs in a given state is kept up to date from these counters, so that
+ * the aggregated quality of an operation is read without walking its inputs.
+ * Inputs with a good quality (empty mask) cost nothing to add or remove.
+ */
+class QualityCounts {
+public:
+    void reset(std::size_t operationCount);
+    void swap(QualityCounts& other);
+
+    void add(int operationIndex, int state, uint16_t quality);
+    void remove(int operationIndex, int state, uint16_t quality);
+    void copyOperation(int operationIndex, const QualityCounts& other, int otherIndex);
+
+    // OR of the quality masks of the inputs of the operation in the given state
+    uint16_t getMask(int operationIndex, int state) const { return m_masks[operationIndex * PointState::StateCount + state]; }
+    // OR of the quality masks of all inputs of the operation
+    uint16_t getWorstMask(int operationIndex) const;
+
+private:
+    std::vector<uint32_t> m_bitCounts;
+    std::vector<uint16_t> m_masks;
+};
+
+#endif  // INCLUDE_QUALITY_COUNTS_H_
@@ -0,0 +1,79 @@
+#ifndef INCLUDE_STATE_STORE_H_
+#define INCLUDE_STATE_STORE_H_
+
+/*
+ * Persistence of the state of the inputs on local disk, for warm restarts
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * State of an input as stored on disk (see InputStateTable)
+ */
+struct PersistedInput {
+    uint8_t state = 0;
+    uint16_t quality = 0;
+    // Packed timestamp (PivotTimestamp) of the last reading of the input
+    uint64_t timestamp = 0;
+};
+
+/**
+ * State of the inputs stored in two files:
+ *     <path>          binary snapshot of every input, replaced atomically (written to <path>.tmp then renamed)
+ *     <path>.journal  append-only journal of the changes made since the snapshot
+ * Both files start with the generation of the snapshot: a journal left from an older generation (crash while
+ * a snapshot was replaced) is ignored. Every entry ends with a checksum so that a torn write at the end of the
+ * journal is detected and dropped.
+ * Changes are buffered by record and written with a single write and fdatasync by flush, called by StateWriter once per flush interval.
+ * Files are read through a memory mapping when the store is opened.
+ */
+class StateStore {
+public:
+    StateStore() = default;
+    ~StateStore();
+    StateStore(const StateStore&) = delete;
+    StateStore& operator=(const StateStore&) = delete;
+
+    bool open(const std::string& path, std::unordered_map<std::string, PersistedInput>& out_inputs, uint64_t& out_snapshotTime);
+    void close();
+    bool isOpen() const { return m_journalFd >= 0; }
+    const std::string& getPath() const { return m_path; }
+
+    void record(const std::string& pivotId, const PersistedInput& input);
+    bool flush();
+    // Number of changes in the journal since the last snapshot, including the ones still buffered
+    std::size_t getJournalRecordCount() const { return m_journalRecordCount; }
+
+    bool beginSnapshot();
+    void addSnapshotEntry(const std::string& pivotId, const PersistedInput& input);
+    bool commitSnapshot();
+
+private:
+    static void appendEntry(std::vector<char>& out_buffer, const std::string& pivotId, const PersistedInput& input);
+    static std::size_t readEntry(const char* data, std::size_t size, std::string& out_pivotId, PersistedInput& out_input);
+    bool loadSnapshot(std::unordered_map<std::string, PersistedInput>& out_inputs, uint64_t& out_snapshotTime);
+    std::size_t loadJournal(std::unordered_map<std::string, PersistedInput>& out_inputs);
+    bool resetJournal();
+    bool writeAll(int fd, const char* data, std::size_t size) const;
+
+    std::string m_path;
+    uint64_t m_generation = 0;
+    int m_journalFd = -1;
+    std::size_t m_journalRecordCount = 0;
+    // Journal records not written yet
+    std::vector<char> m_journalBuffer;
+    // Snapshot being written by beginSnapshot/addSnapshotEntry
+    int m_snapshotFd = -1;
+    uint64_t m_snapshotEntryCount = 0;
+    std::vector<char> m_snapshotBuffer;
+};
+
+#endif  // INCLUDE_STATE_STORE_H_
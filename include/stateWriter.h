@@ -0,0 +1,86 @@
+#ifndef INCLUDE_STATE_WRITER_H_
+#define INCLUDE_STATE_WRITER_H_
+
+/*
+ * Thread writing the state of the inputs to the state store, out of the ingest critical section
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "configOperation.h"
+#include "stateStore.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Owner of a StateStore written by a thread of its own: ingest only queues the changes of the input states,
+ * and the copies of the input states to write in a new snapshot.
+ * The thread writes the queued tasks in order, so the changes queued after a snapshot go to the journal it starts.
+ * The journal is flushed (write and fdatasync) at most once per flush interval, or as soon as FlushMaxRecords
+ * changes are buffered: the changes made during the last interval are lost if the system crashes.
+ * A store that failed is closed by the thread, isOpen then returns false and the tasks queued are dropped.
+ */
+class StateWriter {
+public:
+    // Changes of input states, given by the index of the input in the configuration
+    typedef std::vector<std::pair<int, PersistedInput>> Changes;
+
+    StateWriter() = default;
+    ~StateWriter();
+    StateWriter(const StateWriter&) = delete;
+    StateWriter& operator=(const StateWriter&) = delete;
+
+    bool open(const std::string& path, std::unordered_map<std::string, PersistedInput>& out_inputs, uint64_t& out_snapshotTime);
+    void close();
+    bool isOpen() const { return m_open; }
+    void setFlushInterval(long milliseconds) { m_flushInterval = milliseconds; }
+
+    void record(const std::shared_ptr<const ConfigOperation>& config, Changes&& changes);
+    void snapshot(const std::shared_ptr<const ConfigOperation>& config, std::vector<PersistedInput>&& inputs);
+    // Number of changes queued since the last snapshot, including the ones in the journal when the store was opened
+    std::size_t getJournalRecordCount() const { return m_journalRecordCount; }
+
+    // Number of buffered changes flushed without waiting for the end of the flush interval
+    static const std::size_t FlushMaxRecords = 65536;
+
+private:
+    // Changes to add to the journal, or input states to write in a new snapshot
+    struct Task {
+        std::shared_ptr<const ConfigOperation> config;
+        bool isSnapshot = false;
+        Changes changes;
+        std::vector<PersistedInput> inputs;
+    };
+
+    void pushTask(Task&& task);
+    void writerLoop();
+    void writeTask(Task& task, std::size_t& bufferedRecords);
+    void flushJournal(std::size_t& bufferedRecords);
+
+    StateStore m_store;
+    std::thread m_thread;
+    std::atomic<bool> m_open{false};
+    std::atomic<long> m_flushInterval{0};
+    // Only used by the thread queuing the tasks
+    std::size_t m_journalRecordCount = 0;
+    // Protects m_tasks and m_stop
+    std::mutex m_mutex;
+    std::condition_variable m_taskQueued;
+    std::deque<Task> m_tasks;
+    bool m_stop = false;
+};
+
+#endif  // INCLUDE_STATE_WRITER_H_
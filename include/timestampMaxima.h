@@ -0,0 +1,50 @@
+#ifndef INCLUDE_TIMESTAMP_MAXIMA_H_
+#define INCLUDE_TIMESTAMP_MAXIMA_H_
+
+/*
+ * Running maximum of the timestamps of the inputs of the operations
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "pointState.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * For each compiled operation, newest packed timestamp (see PivotTimestamp) of its inputs in each state and of all its inputs.
+ * Timestamps of an input normally only grow, so a running maximum is enough. When the input holding the maximum
+ * of a group leaves it or goes back in time, the group is marked stale and must be recomputed from the inputs
+ * by the caller before being read again.
+ */
+class TimestampMaxima {
+public:
+    // Group of all the inputs of an operation, following the groups of each state
+    static const int AllInputs = PointState::StateCount;
+
+    void reset(std::size_t operationCount);
+    void swap(TimestampMaxima& other);
+
+    void add(int operationIndex, int state, uint64_t timestamp);
+    void move(int operationIndex, int oldState, uint64_t oldTimestamp, int newState, uint64_t newTimestamp);
+    void copyOperation(int operationIndex, const TimestampMaxima& other, int otherIndex);
+
+    bool isStale(int operationIndex, int group) const { return m_stale[slot(operationIndex, group)] != 0; }
+    void setMaximum(int operationIndex, int group, uint64_t timestamp);
+    uint64_t getMaximum(int operationIndex, int group) const { return m_maxima[slot(operationIndex, group)]; }
+
+private:
+    static const int GroupCount = PointState::StateCount + 1;
+    static std::size_t slot(int operationIndex, int group) { return static_cast<std::size_t>(operationIndex) * GroupCount + group; }
+    void raise(std::size_t groupSlot, uint64_t timestamp);
+    void lower(std::size_t groupSlot, uint64_t timestamp);
+
+    std::vector<uint64_t> m_maxima;
+    std::vector<uint8_t> m_stale;
+};
+
+#endif  // INCLUDE_TIMESTAMP_MAXIMA_H_
@@ -32,6 +32,12 @@ namespace UtilityOperation {
      * @return List of strings extracted from the initial string
     */
     std::vector<std::string> split(const std::string& str, char sep);
+    /**
+     * Escape a string to write it between double quotes in a JSON document
+     * @param str : String to escape
+     * @return String with quotes, backslashes and control characters escaped
+    */
+    std::string escapeJson(const std::string& str);
 
     /*
      * Log helper function that will log both in the Fledge syslog file and in stdout for unit tests
@@ -80,6 +86,49 @@ namespace UtilityOperation {
         #endif
         Logger::getLogger()->fatal(format.c_str(), std::forward<Args>(args)...);
     }
+
+    enum class LogLevel { Debug, Info, Warning, Error, Fatal };
+
+    /**
+     * Check if messages of the given level are currently written by the Fledge logger
+     * Unit tests set the minimum level of the logger to debug so that all messages are printed in stdout
+     * @param level : Level of the message to log
+     * @return true if the message would be logged, else false
+    */
+    inline bool isLogLevelEnabled(LogLevel level) {
+        // Fledge log levels are "debug", "info", "warning", "error" and "fatal", their first letter is enough to tell them apart
+        const std::string& minLevel = Logger::getLogger()->getMinLevel();
+        LogLevel minLogLevel = LogLevel::Warning;
+        switch (minLevel.empty() ? 'w' : minLevel[0]) {
+            case 'd': minLogLevel = LogLevel::Debug; break;
+            case 'i': minLogLevel = LogLevel::Info; break;
+            case 'e': minLogLevel = LogLevel::Error; break;
+            case 'f': minLogLevel = LogLevel::Fatal; break;
+            default: break;
+        }
+        return level >= minLogLevel;
+    }
 }
 
+/*
+ * Log macros to use on the ingest path: the arguments are only evaluated if the level is enabled.
+ * Debug logs can be removed at compile time by defining SPOPERATORS_DISABLE_DEBUG_LOG
+ */
+#ifdef SPOPERATORS_DISABLE_DEBUG_LOG
+// Arguments are still type-checked but never evaluated
+#define SPOPERATORS_LOG_DEBUG(...) \
+    do { \
+        if (false) { \
+            UtilityOperation::log_debug(__VA_ARGS__); \
+        } \
+    } while (0)
+#else
+#define SPOPERATORS_LOG_DEBUG(...) \
+    do { \
+        if (UtilityOperation::isLogLevelEnabled(UtilityOperation::LogLevel::Debug)) { \
+            UtilityOperation::log_debug(__VA_ARGS__); \
+        } \
+    } while (0)
+#endif
+
 #endif /* INCLUDE_UTILITY_OPERATION_H */
\ No newline at end of file
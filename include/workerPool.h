@@ -0,0 +1,67 @@
+#ifndef INCLUDE_WORKER_POOL_H_
+#define INCLUDE_WORKER_POOL_H_
+
+/*
+ * Pool of threads running the tasks of a parallel ingest
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of workers running batches of independent tasks.
+ * The thread calling run is one of the workers, the others are threads started once by the constructor.
+ * Tasks are dealt round-robin to the queue of each worker, a worker whose queue is empty steals the last
+ * task of the queue of another worker, so that uneven tasks keep every worker busy.
+ */
+class WorkerPool {
+public:
+    // Function running a task, given the index of the task and of the worker running it
+    typedef std::function<void(std::size_t taskIndex, std::size_t workerIndex)> Task;
+
+    explicit WorkerPool(std::size_t workerCount);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    std::size_t getWorkerCount() const { return m_queues.size(); }
+    void run(std::size_t taskCount, const Task& task);
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    void workerLoop(std::size_t workerIndex);
+    bool runTasks(std::size_t workerIndex);
+    bool popTask(std::size_t workerIndex, std::size_t& out_taskIndex);
+
+    std::vector<std::unique_ptr<TaskQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+    // Protects m_batch, m_stop and the end of a batch
+    std::mutex m_mutex;
+    std::condition_variable m_batchStarted;
+    std::condition_variable m_batchDone;
+    // Incremented by run for each batch of tasks
+    unsigned long m_batch = 0;
+    bool m_stop = false;
+    const Task* m_task = nullptr;
+    std::atomic<std::size_t> m_remainingTasks;
+    // First exception thrown by a task of the batch, rethrown by run
+    std::exception_ptr m_error;
+};
+
+#endif  // INCLUDE_WORKER_POOL_H_
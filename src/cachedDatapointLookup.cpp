@@ -0,0 +1,64 @@
+/*
+ * Lookup of a named child datapoint remembering where it was last found
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "cachedDatapointLookup.h"
+
+using namespace std;
+
+/**
+ * Find a child datapoint by name
+ * Names are expected to be unique in the list, as they are in a PIVOT dict
+ *
+ * @param datapoints : List of datapoints to search in (can be null)
+ * @return The datapoint with the expected name, or null if not found
+ */
+Datapoint *CachedDatapointLookup::find(vector<Datapoint*>* datapoints) {
+    if (datapoints == nullptr) {
+        return nullptr;
+    }
+    size_t size = datapoints->size();
+    if (m_lastPosition < size && (*datapoints)[m_lastPosition]->getName() == m_name) {
+        return (*datapoints)[m_lastPosition];
+    }
+    for (size_t position = 0 ; position < size ; position++) {
+        Datapoint *dp = (*datapoints)[position];
+        if (dp->getName() == m_name) {
+            m_lastPosition = position;
+            return dp;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Find a child dict datapoint by name
+ *
+ * @param datapoints : List of datapoints to search in (can be null)
+ * @return The children of the datapoint with the expected name, or null if not found or not a dict
+ */
+vector<Datapoint*> *CachedDatapointLookup::findDict(vector<Datapoint*>* datapoints) {
+    Datapoint *dp = find(datapoints);
+    if (dp == nullptr || dp->getData().getType() != DatapointValue::T_DP_DICT) {
+        return nullptr;
+    }
+    return dp->getData().getDpVec();
+}
+
+/**
+ * Find the value of a child datapoint by name
+ *
+ * @param datapoints : List of datapoints to search in (can be null)
+ * @return The value of the datapoint with the expected name, or null if not found
+ */
+DatapointValue *CachedDatapointLookup::findValue(vector<Datapoint*>* datapoints) {
+    Datapoint *dp = find(datapoints);
+    if (dp == nullptr) {
+        return nullptr;
+    }
+    return &dp->getData();
+}
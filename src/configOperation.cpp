@@ -1,22 +1,111 @@
 #include "configOperation.h"
 #include "constantsOperation.h"
+#include "pointState.h"
 #include "utilityOperation.h"
 
 #include <rapidjson/error/en.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace std;
 using namespace rapidjson;
 
+namespace {
+    std::atomic<unsigned long> nextGeneration(1);
+
+    /**
+     * Definition of a supported operation type
+     */
+    struct OperatorDefinition {
+        OperationKernel kernel;
+        // Computes the parameter of the kernel from the number of inputs and the "k" parameter of the operation
+        uint32_t (*kernelParameter)(std::size_t inputCount, unsigned int threshold);
+        // The operation requires the "k" parameter, between 1 and the number of inputs
+        bool requiresThreshold;
+        // The operation requires exactly one input
+        bool singleInput;
+        // The operation requires at least one input, without inputs it would be on
+        bool requiresInput;
+    };
+
+    // Registry of the supported operation types, only used when importing a configuration
+    const std::map<std::string, OperatorDefinition> operatorRegistry = {
+        {ConstantsOperation::OperationOr, {OperationKernel::Threshold,
+            [](std::size_t, unsigned int) -> uint32_t { return 1; }, false, false, false}},
+        {ConstantsOperation::OperationAnd, {OperationKernel::Threshold,
+            [](std::size_t inputCount, unsigned int) -> uint32_t { return static_cast<uint32_t>(inputCount); }, false, false, true}},
+        {ConstantsOperation::OperationCountGe, {OperationKernel::Threshold,
+            [](std::size_t, unsigned int threshold) -> uint32_t { return threshold; }, true, false, true}},
+        {ConstantsOperation::OperationMajority, {OperationKernel::Threshold,
+            [](std::size_t inputCount, unsigned int) -> uint32_t { return static_cast<uint32_t>(inputCount / 2 + 1); }, false, false, true}},
+        {ConstantsOperation::OperationXor, {OperationKernel::Parity,
+            [](std::size_t, unsigned int) -> uint32_t { return 0; }, false, false, false}},
+        {ConstantsOperation::OperationNot, {OperationKernel::Parity,
+            [](std::size_t, unsigned int) -> uint32_t { return 1; }, false, true, true}},
+    };
+
+    /**
+     * Check if two outputs are configured with exactly the same operations
+     *
+     * @param lhs : First output configuration
+     * @param rhs : Second output configuration
+     * @return true if both configurations produce the same readings, else false
+     */
+    bool sameOperations(const OperationsInfo& lhs, const OperationsInfo& rhs) {
+        if (lhs.outputPivotType != rhs.outputPivotType || lhs.outputAssetName != rhs.outputAssetName
+            || lhs.operations.size() != rhs.operations.size()) {
+            return false;
+        }
+        for(std::size_t i=0 ; i<lhs.operations.size() ; i++) {
+            if (lhs.operations[i].operationType != rhs.operations[i].operationType
+                || lhs.operations[i].threshold != rhs.operations[i].threshold
+                || lhs.operations[i].expression != rhs.operations[i].expression
+                || lhs.operations[i].inputPivotIds != rhs.operations[i].inputPivotIds) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+ConfigOperation::ConfigOperation():
+    m_generation(nextGeneration++)
+{
+    m_lookupOffsets.assign(1, 0);
+}
+
 /**
  * Import data in the form of Exchanged_data
  * The data is saved in a maps m_dataOperation
+ * When a previous configuration is given, the differences with it are computed so that
+ * unchanged outputs reuse its compiled data and the state of their operations can be kept
  * 
  * @param exchangeConfig : configuration Exchanged_data as a string 
+ * @param previous : configuration currently in use (can be null)
 */
-void ConfigOperation::importExchangedData(const string & exchangeConfig) {
+void ConfigOperation::importExchangedData(const string & exchangeConfig, const ConfigOperation* previous /*= nullptr*/) {
     std::string beforeLog = ConstantsOperation::NamePlugin + " - ConfigOperation::importExchangedData :";
     m_dataOperation.clear();
     m_dataOperationLookup.clear();
+    m_pivotIndexes.clear();
+    m_pivotIds.clear();
+    m_pivotOutputIndexes.clear();
+    m_compiledOutputs.clear();
+    m_compiledOperations.clear();
+    m_operationInputs.clear();
+    m_expressionCode.clear();
+    m_lookupOffsets.assign(1, 0);
+    m_lookupEntries.clear();
+    m_fanOutEstimate = 0;
+    m_chainLevelCount = 1;
+    m_pivotComponents.clear();
+    m_componentCount = 0;
+    m_generation = nextGeneration++;
+    m_baseGeneration = 0;
+    m_diff = ConfigOperationDiff();
+    m_previousPivotIndexes.clear();
+    m_previousOperationIndexes.clear();
     Document document;
 
     if (document.Parse(exchangeConfig.c_str()).HasParseError()) {
@@ -52,6 +141,340 @@ void ConfigOperation::importExchangedData(const string & exchangeConfig) {
             UtilityOperation::log_warn("%s An operation is configured for unexisting Pivot ID '%s'", beforeLog.c_str(), kvp.first.c_str());
         }
     }
+
+    compileOperations(previous);
+
+    if (previous != nullptr) {
+        UtilityOperation::log_info("%s Operations updated: %zu added, %zu removed, %zu modified, %zu unchanged output datapoints", beforeLog.c_str(),
+                                   m_diff.added, m_diff.removed, m_diff.modified, m_diff.unchanged);
+    }
+}
+
+/**
+ * Build the compiled operation graph from m_dataOperation and m_dataOperationLookup
+ * Every pivot ID is interned into a dense index so that the ingest path only needs
+ * a single hash lookup per reading, then only works on flat arrays
+ * 
+ * @param previous : configuration to compare with (can be null)
+*/
+void ConfigOperation::compileOperations(const ConfigOperation* previous) {
+    std::string beforeLog = ConstantsOperation::NamePlugin + " - ConfigOperation::compileOperations :";
+    // Both maps are sorted by pivot ID and outputs are compiled in map order, so they are compared in a single merge pass
+    std::map<std::string, OperationsInfo>::const_iterator previousIt;
+    int previousOutputIndex = 0;
+    if (previous != nullptr) {
+        m_baseGeneration = previous->m_generation;
+        previousIt = previous->m_dataOperation.begin();
+    }
+
+    for(const auto& kvp: m_dataOperation) {
+        const OperationsInfo& operationsInfo = kvp.second;
+        const CompiledOutput* previousOutput = nullptr;
+        bool unchanged = false;
+        if (previous != nullptr) {
+            while (previousIt != previous->m_dataOperation.end() && previousIt->first < kvp.first) {
+                SPOPERATORS_LOG_DEBUG("%s Operations removed for output %s", beforeLog.c_str(), previousIt->first.c_str());
+                m_diff.removed++;
+                ++previousIt;
+                previousOutputIndex++;
+            }
+            if (previousIt != previous->m_dataOperation.end() && previousIt->first == kvp.first) {
+                previousOutput = &previous->m_compiledOutputs[previousOutputIndex];
+                unchanged = sameOperations(previousIt->second, operationsInfo);
+                ++previousIt;
+                previousOutputIndex++;
+            }
+            if (unchanged) {
+                m_diff.unchanged++;
+            }
+            else if (previousOutput != nullptr) {
+                SPOPERATORS_LOG_DEBUG("%s Operations modified for output %s", beforeLog.c_str(), kvp.first.c_str());
+                m_diff.modified++;
+            }
+            else {
+                SPOPERATORS_LOG_DEBUG("%s Operations added for output %s", beforeLog.c_str(), kvp.first.c_str());
+                m_diff.added++;
+            }
+        }
+
+        CompiledOutput compiledOutput;
+        compiledOutput.pivotIndex = internPivotId(kvp.first);
+        compiledOutput.pivotType = operationsInfo.outputPivotType;
+        compiledOutput.typeSps = (operationsInfo.outputPivotType == ConstantsOperation::JsonCdcSps);
+        compiledOutput.assetName = operationsInfo.outputAssetName;
+        // The template only depends on the pivot ID and type of the output
+        if (previousOutput != nullptr && previousOutput->pivotType == operationsInfo.outputPivotType) {
+            compiledOutput.readingTemplate = previousOutput->readingTemplate;
+        }
+        else {
+            compiledOutput.readingTemplate = std::make_shared<OutputTemplate>(kvp.first, operationsInfo.outputPivotType);
+        }
+        compiledOutput.operationBegin = static_cast<int>(m_compiledOperations.size());
+        int outputIndex = static_cast<int>(m_compiledOutputs.size());
+        for(int i=0 ; i<operationsInfo.operations.size() ; i++) {
+            m_previousOperationIndexes.push_back(unchanged ? previousOutput->operationBegin + i : -1);
+            CompiledOperation compiledOperation;
+            compiledOperation.outputIndex = outputIndex;
+            compiledOperation.operationIndex = i;
+            compiledOperation.inputBegin = m_operationInputs.size();
+            for(const auto& inputPivotId: operationsInfo.operations[i].inputPivotIds) {
+                m_operationInputs.push_back(internPivotId(inputPivotId));
+            }
+            compiledOperation.inputEnd = m_operationInputs.size();
+            // Operation types were checked on import, the operation is only dispatched on its kernel from now on
+            const OperationInfo& operationInfo = operationsInfo.operations[i];
+            if (operationInfo.operationType == ConstantsOperation::OperationExpression) {
+                compiledOperation.kernel = OperationKernel::Expression;
+                compiledOperation.kernelParameter = static_cast<uint32_t>(m_expressionCode.size());
+                m_expressionCode.insert(m_expressionCode.end(), operationInfo.expressionCode.begin(), operationInfo.expressionCode.end());
+            }
+            else {
+                const OperatorDefinition& definition = operatorRegistry.at(operationInfo.operationType);
+                compiledOperation.kernel = definition.kernel;
+                compiledOperation.kernelParameter = definition.kernelParameter(operationInfo.inputPivotIds.size(), operationInfo.threshold);
+            }
+            m_compiledOperations.push_back(compiledOperation);
+        }
+        compiledOutput.operationEnd = static_cast<int>(m_compiledOperations.size());
+        m_pivotOutputIndexes[compiledOutput.pivotIndex] = outputIndex;
+        m_compiledOutputs.push_back(compiledOutput);
+    }
+
+    if (previous != nullptr) {
+        for (; previousIt != previous->m_dataOperation.end() ; ++previousIt) {
+            SPOPERATORS_LOG_DEBUG("%s Operations removed for output %s", beforeLog.c_str(), previousIt->first.c_str());
+            m_diff.removed++;
+        }
+    }
+
+    // Build lookup table in CSR form, keeping the order of m_dataOperationLookup entries for each input
+    std::size_t pivotCount = m_pivotIds.size();
+    std::vector<std::size_t> lookupCounts(pivotCount, 0);
+    for(const auto& kvp: m_dataOperationLookup) {
+        lookupCounts[m_pivotIndexes.at(kvp.first)] = kvp.second.size();
+    }
+    m_lookupOffsets.assign(pivotCount + 1, 0);
+    std::size_t inputCount = 0;
+    for(std::size_t i=0 ; i<pivotCount ; i++) {
+        m_lookupOffsets[i + 1] = m_lookupOffsets[i] + lookupCounts[i];
+        if (lookupCounts[i] > 0) {
+            inputCount++;
+        }
+    }
+    m_fanOutEstimate = inputCount > 0 ? (m_lookupOffsets[pivotCount] + inputCount - 1) / inputCount : 0;
+    m_lookupEntries.resize(m_lookupOffsets[pivotCount]);
+    for(const auto& kvp: m_dataOperationLookup) {
+        std::size_t entryIndex = m_lookupOffsets[m_pivotIndexes.at(kvp.first)];
+        for(const auto& operationLookup: kvp.second) {
+            int outputIndex = m_pivotOutputIndexes[m_pivotIndexes.at(operationLookup.outputPivotId)];
+            const CompiledOutput& compiledOutput = m_compiledOutputs[outputIndex];
+            m_lookupEntries[entryIndex++] = CompiledLookup(compiledOutput.pivotIndex,
+                                                           compiledOutput.operationBegin + operationLookup.operationIndex);
+        }
+    }
+
+    m_previousPivotIndexes.assign(pivotCount, -1);
+    if (previous != nullptr) {
+        for(std::size_t i=0 ; i<pivotCount ; i++) {
+            m_previousPivotIndexes[i] = previous->getPivotIndex(m_pivotIds[i]);
+        }
+    }
+
+    compileChains();
+    compileComponents();
+}
+
+/**
+ * Partition the pivots in connected components: an output and all the inputs of its operations are in the same component
+ * Readings of pivots in different components update disjoint states, so that they can be processed in parallel
+*/
+void ConfigOperation::compileComponents() {
+    // Union-find with path halving, every root is the smallest pivot index of its set
+    std::size_t pivotCount = m_pivotIds.size();
+    std::vector<int> parents(pivotCount);
+    for(std::size_t i=0 ; i<pivotCount ; i++) {
+        parents[i] = static_cast<int>(i);
+    }
+    auto findRoot = [&parents](int pivotIndex) {
+        while (parents[pivotIndex] != pivotIndex) {
+            parents[pivotIndex] = parents[parents[pivotIndex]];
+            pivotIndex = parents[pivotIndex];
+        }
+        return pivotIndex;
+    };
+    for(const auto& compiledOperation: m_compiledOperations) {
+        int outputRoot = findRoot(m_compiledOutputs[compiledOperation.outputIndex].pivotIndex);
+        for(int inputPivotIndex: getOperationInputs(compiledOperation)) {
+            int inputRoot = findRoot(inputPivotIndex);
+            if (inputRoot < outputRoot) {
+                parents[outputRoot] = inputRoot;
+                outputRoot = inputRoot;
+            }
+            else if (inputRoot > outputRoot) {
+                parents[inputRoot] = outputRoot;
+            }
+        }
+    }
+    // Components are numbered in order of their smallest pivot index
+    m_pivotComponents.assign(pivotCount, -1);
+    m_componentCount = 0;
+    for(std::size_t i=0 ; i<pivotCount ; i++) {
+        int root = findRoot(static_cast<int>(i));
+        if (m_pivotComponents[root] < 0) {
+            m_pivotComponents[root] = static_cast<int>(m_componentCount++);
+        }
+        m_pivotComponents[i] = m_pivotComponents[root];
+    }
+}
+
+/**
+ * Find the outputs used as inputs of other operations and rank them in topological order
+ * An output whose own operations use it as input keeps its value from the readings received for it, it is not chained.
+ * Outputs involved in a cycle are not chained either, they are reported as errors.
+*/
+void ConfigOperation::compileChains() {
+    std::string beforeLog = ConstantsOperation::NamePlugin + " - ConfigOperation::compileChains :";
+    bool anyChained = false;
+    for(auto& compiledOutput: m_compiledOutputs) {
+        if (getCompiledOperationsForInput(compiledOutput.pivotIndex).empty()) {
+            continue;
+        }
+        compiledOutput.chained = true;
+        for(int i=compiledOutput.operationBegin ; i<compiledOutput.operationEnd ; i++) {
+            for(int inputPivotIndex: getOperationInputs(m_compiledOperations[i])) {
+                if (inputPivotIndex == compiledOutput.pivotIndex) {
+                    compiledOutput.chained = false;
+                }
+            }
+        }
+        anyChained = anyChained || compiledOutput.chained;
+    }
+    if (!anyChained || computeChainLevels()) {
+        return;
+    }
+
+    // Outputs left without level are on a cycle, or between two cycles, or downstream of a cycle.
+    // Trim the ones downstream: outputs whose chained successors all have a level or were trimmed
+    std::size_t outputCount = m_compiledOutputs.size();
+    std::vector<std::vector<int>> predecessors(outputCount);
+    std::vector<std::size_t> unresolvedSuccessors(outputCount, 0);
+    std::vector<bool> unresolved(outputCount, false);
+    for(std::size_t outputIndex=0 ; outputIndex<outputCount ; outputIndex++) {
+        unresolved[outputIndex] = (m_compiledOutputs[outputIndex].chainLevel < 0);
+    }
+    for(std::size_t outputIndex=0 ; outputIndex<outputCount ; outputIndex++) {
+        const CompiledOutput& compiledOutput = m_compiledOutputs[outputIndex];
+        if (!unresolved[outputIndex] || !compiledOutput.chained) {
+            continue;
+        }
+        for(const auto& lookup: getCompiledOperationsForInput(compiledOutput.pivotIndex)) {
+            int successor = m_compiledOperations[lookup.compiledOperationIndex].outputIndex;
+            if (unresolved[successor]) {
+                predecessors[successor].push_back(static_cast<int>(outputIndex));
+                unresolvedSuccessors[outputIndex]++;
+            }
+        }
+    }
+    std::vector<int> trimmed;
+    for(std::size_t outputIndex=0 ; outputIndex<outputCount ; outputIndex++) {
+        if (unresolved[outputIndex] && unresolvedSuccessors[outputIndex] == 0) {
+            trimmed.push_back(static_cast<int>(outputIndex));
+        }
+    }
+    while (!trimmed.empty()) {
+        int outputIndex = trimmed.back();
+        trimmed.pop_back();
+        unresolved[outputIndex] = false;
+        for(int predecessor: predecessors[outputIndex]) {
+            if (--unresolvedSuccessors[predecessor] == 0) {
+                trimmed.push_back(predecessor);
+            }
+        }
+    }
+    std::vector<std::string> cyclePivotIds;
+    for(std::size_t outputIndex=0 ; outputIndex<outputCount ; outputIndex++) {
+        if (unresolved[outputIndex]) {
+            m_compiledOutputs[outputIndex].chained = false;
+            cyclePivotIds.push_back(m_pivotIds[m_compiledOutputs[outputIndex].pivotIndex]);
+        }
+    }
+    UtilityOperation::log_error("%s Operations of outputs [%s] form a cycle, their computed values are not fed to the operations using them",
+                                beforeLog.c_str(), UtilityOperation::join(cyclePivotIds).c_str());
+    computeChainLevels();
+}
+
+/**
+ * Compute the chain level of every output, in topological order of the chained outputs (Kahn's algorithm)
+ * The level of an output is the length of the longest chain of chained outputs leading to it
+ *
+ * @return true if every output got a level, false if chained outputs form a cycle (outputs left without level are set to -1)
+*/
+bool ConfigOperation::computeChainLevels() {
+    std::size_t outputCount = m_compiledOutputs.size();
+    std::vector<std::size_t> chainedInputs(outputCount, 0);
+    for(const auto& compiledOutput: m_compiledOutputs) {
+        if (!compiledOutput.chained) {
+            continue;
+        }
+        for(const auto& lookup: getCompiledOperationsForInput(compiledOutput.pivotIndex)) {
+            chainedInputs[m_compiledOperations[lookup.compiledOperationIndex].outputIndex]++;
+        }
+    }
+    std::vector<int> levels(outputCount, 0);
+    std::vector<int> ready;
+    for(std::size_t outputIndex=0 ; outputIndex<outputCount ; outputIndex++) {
+        if (chainedInputs[outputIndex] == 0) {
+            ready.push_back(static_cast<int>(outputIndex));
+        }
+    }
+    std::size_t resolvedCount = 0;
+    int maxLevel = 0;
+    while (!ready.empty()) {
+        int outputIndex = ready.back();
+        ready.pop_back();
+        resolvedCount++;
+        const CompiledOutput& compiledOutput = m_compiledOutputs[outputIndex];
+        m_compiledOutputs[outputIndex].chainLevel = levels[outputIndex];
+        maxLevel = std::max(maxLevel, levels[outputIndex]);
+        if (!compiledOutput.chained) {
+            continue;
+        }
+        for(const auto& lookup: getCompiledOperationsForInput(compiledOutput.pivotIndex)) {
+            int successor = m_compiledOperations[lookup.compiledOperationIndex].outputIndex;
+            levels[successor] = std::max(levels[successor], levels[outputIndex] + 1);
+            if (--chainedInputs[successor] == 0) {
+                ready.push_back(successor);
+            }
+        }
+    }
+    m_chainLevelCount = maxLevel + 1;
+    if (resolvedCount == outputCount) {
+        return true;
+    }
+    for(std::size_t outputIndex=0 ; outputIndex<outputCount ; outputIndex++) {
+        if (chainedInputs[outputIndex] > 0) {
+            m_compiledOutputs[outputIndex].chainLevel = -1;
+        }
+    }
+    return false;
+}
+
+/**
+ * Get the dense index of a pivot ID, creating it if needed
+ *
+ * @param pivotId : Pivot ID to intern
+ * @return Dense index of the pivot ID
+*/
+int ConfigOperation::internPivotId(const std::string& pivotId) {
+    auto it = m_pivotIndexes.find(pivotId);
+    if (it != m_pivotIndexes.end()) {
+        return it->second;
+    }
+    int pivotIndex = static_cast<int>(m_pivotIds.size());
+    m_pivotIndexes.emplace(pivotId, pivotIndex);
+    m_pivotIds.push_back(pivotId);
+    m_pivotOutputIndexes.push_back(-1);
+    return pivotIndex;
 }
 
 /**
@@ -110,9 +533,9 @@ void ConfigOperation::importDataPoint(const Value& datapoint, std::set<std::stri
             continue;
         }
         operationsInfo.operations.push_back(operationInfo);
-        UtilityOperation::log_debug("%s Configured '%s' operation for inputs [%s] and output %s", beforeLog.c_str(),
-                                    operationInfo.operationType.c_str(), UtilityOperation::join(operationInfo.inputPivotIds).c_str(),
-                                    outputPivotId.c_str());
+        SPOPERATORS_LOG_DEBUG("%s Configured '%s' operation for inputs [%s] and output %s", beforeLog.c_str(),
+                              operationInfo.operationType.c_str(), UtilityOperation::join(operationInfo.inputPivotIds).c_str(),
+                              outputPivotId.c_str());
     }
     if (operationsInfo.operations.empty()) {
         return;
@@ -147,16 +570,49 @@ bool ConfigOperation::importOperation(rapidjson::Value::ConstValueIterator itr,
     }
     auto operation = (*itr).GetObject();
 
+    // An expression replaces the operation type and the inputs, which are the pivot IDs it references
+    if (operation.HasMember(ConstantsOperation::JsonExpression)) {
+        if (!operation[ConstantsOperation::JsonExpression].IsString()) {
+            UtilityOperation::log_error("%s %s is not a string", beforeLog.c_str(), ConstantsOperation::JsonExpression);
+            return false;
+        }
+        if (operation.HasMember(ConstantsOperation::JsonOperation) || operation.HasMember(ConstantsOperation::JsonInput)) {
+            UtilityOperation::log_error("%s %s cannot be used with %s or %s", beforeLog.c_str(), ConstantsOperation::JsonExpression,
+                                        ConstantsOperation::JsonOperation, ConstantsOperation::JsonInput);
+            return false;
+        }
+        out_operationInfo.operationType = ConstantsOperation::OperationExpression;
+        out_operationInfo.expression = operation[ConstantsOperation::JsonExpression].GetString();
+        std::string error;
+        if (!OperationExpression::parse(out_operationInfo.expression, out_operationInfo.inputPivotIds, out_operationInfo.expressionCode, error)) {
+            UtilityOperation::log_error("%s invalid %s '%s': %s", beforeLog.c_str(), ConstantsOperation::JsonExpression,
+                                        out_operationInfo.expression.c_str(), error.c_str());
+            return false;
+        }
+        if (out_operationInfo.inputPivotIds.empty()) {
+            UtilityOperation::log_error("%s %s must reference at least one %s", beforeLog.c_str(), ConstantsOperation::JsonExpression, ConstantsOperation::JsonInput);
+            return false;
+        }
+        if (out_operationInfo.inputPivotIds.size() > StateCounts::FieldMask) {
+            UtilityOperation::log_error("%s %s references more than %llu %s", beforeLog.c_str(), ConstantsOperation::JsonExpression,
+                                        static_cast<unsigned long long>(StateCounts::FieldMask), ConstantsOperation::JsonInput);
+            return false;
+        }
+        return true;
+    }
+
     if (!operation.HasMember(ConstantsOperation::JsonOperation) || !operation[ConstantsOperation::JsonOperation].IsString()) {
         UtilityOperation::log_error("%s %s does not exist or is not a string", beforeLog.c_str(), ConstantsOperation::JsonOperation);
         return false;
     }
 
     out_operationInfo.operationType = operation[ConstantsOperation::JsonOperation].GetString();
-    if (!m_supportedOperationTypes.count(out_operationInfo.operationType)) {
+    auto definitionIt = operatorRegistry.find(out_operationInfo.operationType);
+    if (definitionIt == operatorRegistry.end()) {
         UtilityOperation::log_error("%s '%s' is not a supported operation type", beforeLog.c_str(), out_operationInfo.operationType.c_str());
         return false;
     }
+    const OperatorDefinition& definition = definitionIt->second;
 
     if (!operation.HasMember(ConstantsOperation::JsonInput) || !operation[ConstantsOperation::JsonInput].IsArray()) {
         UtilityOperation::log_error("%s %s does not exist or is not an array", beforeLog.c_str(), ConstantsOperation::JsonInput);
@@ -164,6 +620,12 @@ bool ConfigOperation::importOperation(rapidjson::Value::ConstValueIterator itr,
     }
 
     auto inputs = operation[ConstantsOperation::JsonInput].GetArray();
+    // The inputs in each state are counted in the fields of StateCounts
+    if (inputs.Size() > StateCounts::FieldMask) {
+        UtilityOperation::log_error("%s '%s' operation has more than %llu %s", beforeLog.c_str(), out_operationInfo.operationType.c_str(),
+                                    static_cast<unsigned long long>(StateCounts::FieldMask), ConstantsOperation::JsonInput);
+        return false;
+    }
     for (rapidjson::Value::ConstValueIterator itr2 = inputs.Begin(); itr2 != inputs.End(); ++itr2) {
         if (!(*itr2).IsString()) {
             UtilityOperation::log_error("%s %s element is not a string", beforeLog.c_str(), ConstantsOperation::JsonInput);
@@ -172,6 +634,28 @@ bool ConfigOperation::importOperation(rapidjson::Value::ConstValueIterator itr,
         std::string inputPivotId = (*itr2).GetString();
         out_operationInfo.inputPivotIds.push_back(inputPivotId);
     }
+
+    // "or" and "xor" without inputs are constant off outputs, the other operations would be on
+    if (definition.requiresInput && out_operationInfo.inputPivotIds.empty()) {
+        UtilityOperation::log_error("%s '%s' operation requires at least one %s", beforeLog.c_str(), out_operationInfo.operationType.c_str(), ConstantsOperation::JsonInput);
+        return false;
+    }
+    if (definition.singleInput && out_operationInfo.inputPivotIds.size() != 1) {
+        UtilityOperation::log_error("%s '%s' operation requires exactly one %s", beforeLog.c_str(), out_operationInfo.operationType.c_str(), ConstantsOperation::JsonInput);
+        return false;
+    }
+    if (definition.requiresThreshold) {
+        if (!operation.HasMember(ConstantsOperation::JsonThreshold) || !operation[ConstantsOperation::JsonThreshold].IsUint()) {
+            UtilityOperation::log_error("%s %s does not exist or is not a positive integer", beforeLog.c_str(), ConstantsOperation::JsonThreshold);
+            return false;
+        }
+        out_operationInfo.threshold = operation[ConstantsOperation::JsonThreshold].GetUint();
+        if (out_operationInfo.threshold == 0 || out_operationInfo.threshold > out_operationInfo.inputPivotIds.size()) {
+            UtilityOperation::log_error("%s %s must be between 1 and the number of %s (%zu)", beforeLog.c_str(), ConstantsOperation::JsonThreshold,
+                                        ConstantsOperation::JsonInput, out_operationInfo.inputPivotIds.size());
+            return false;
+        }
+    }
     return true;
 }
 
@@ -190,3 +674,65 @@ const std::vector<OperationInfoLookup>& ConfigOperation::getOperationsForInputId
         return empty;
     }
 }
+
+/**
+ * Returns the dense index of a pivot ID involved in an operation
+ *
+ * @param pivotId : Pivot ID to look for
+ * @return The dense index of the pivot ID, or -1 if it is not involved in any operation
+*/
+int ConfigOperation::getPivotIndex(const std::string& pivotId) const {
+    auto it = m_pivotIndexes.find(pivotId);
+    if (it == m_pivotIndexes.end()) {
+        return -1;
+    }
+    return it->second;
+}
+
+/**
+ * Returns the compiled operations that involves the given input
+ *
+ * @param inputPivotIndex : Dense index of the input pivot ID
+ * @return The range of (output pivot index, compiled operation index) pairs, empty if none
+*/
+ConstSpan<CompiledLookup> ConfigOperation::getCompiledOperationsForInput(int inputPivotIndex) const {
+    if (inputPivotIndex < 0 || inputPivotIndex >= static_cast<int>(m_pivotIds.size())) {
+        return ConstSpan<CompiledLookup>();
+    }
+    const CompiledLookup* entries = m_lookupEntries.data();
+    return ConstSpan<CompiledLookup>(entries + m_lookupOffsets[inputPivotIndex], entries + m_lookupOffsets[inputPivotIndex + 1]);
+}
+
+/**
+ * Returns the dense indexes of the inputs of a compiled operation
+ *
+ * @param operation : Compiled operation
+ * @return The range of input pivot indexes
+*/
+ConstSpan<int> ConfigOperation::getOperationInputs(const CompiledOperation& operation) const {
+    const int* inputs = m_operationInputs.data();
+    return ConstSpan<int>(inputs + operation.inputBegin, inputs + operation.inputEnd);
+}
+
+/**
+ * Returns the index of the compiled operation matching an output pivot ID and an operation index
+ *
+ * @param outputPivotId : Pivot ID of the output
+ * @param operationIndex : Index of the operation for this output
+ * @return The compiled operation index if found, else -1
+*/
+int ConfigOperation::findCompiledOperation(const std::string& outputPivotId, int operationIndex) const {
+    int pivotIndex = getPivotIndex(outputPivotId);
+    if (pivotIndex < 0) {
+        return -1;
+    }
+    int outputIndex = m_pivotOutputIndexes[pivotIndex];
+    if (outputIndex < 0) {
+        return -1;
+    }
+    const CompiledOutput& compiledOutput = m_compiledOutputs[outputIndex];
+    if (operationIndex < 0 || operationIndex >= compiledOutput.operationEnd - compiledOutput.operationBegin) {
+        return -1;
+    }
+    return compiledOutput.operationBegin + operationIndex;
+}
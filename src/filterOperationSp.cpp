@@ -10,15 +10,28 @@
  */
 #include "constantsOperation.h"
 #include "filterOperationSp.h"
+#include "pivotQuality.h"
+#include "pivotTimestamp.h"
+#include "pointState.h"
 #include "utilityOperation.h"
 
 #include <datapoint.h>
 #include <datapoint_utility.h>
 #include <reading.h>
 
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
 using namespace std;
 using namespace DatapointUtility;
 
+const std::size_t FilterOperationSp::SnapshotMinJournalRecords;
+const std::size_t FilterOperationSp::ParallelMinReadings;
+const std::size_t FilterOperationSp::TasksPerWorker;
+const std::size_t FilterOperationSp::MetricsTopOperations;
+const std::size_t FilterOperationSp::MaxReservedFanOut;
+
 /**
  * Constructor for the LogFilter.
  *
@@ -34,18 +47,334 @@ FilterOperationSp::FilterOperationSp(const std::string& filterName,
                         ConfigCategory& filterConfig,
                         OUTPUT_HANDLE *outHandle,
                         OUTPUT_STREAM output) :
-                                FledgeFilter(filterName, filterConfig, outHandle, output)
+                                FledgeFilter(filterName, filterConfig, outHandle, output),
+                                m_publishedConfig(std::make_shared<ConfigOperation>()),
+                                m_activeConfig(m_publishedConfig)
+{
+    m_ingestContexts.emplace_back(new IngestContext);
+    m_options.importConfig(filterConfig);
+    if (!m_options.stateFile.empty()) {
+        restoreState();
+    }
+}
+
+FilterOperationSp::IngestContext::IngestContext():
+    pivotLookup(ConstantsOperation::KeyMessagePivotJsonRoot),
+    gtisLookup(ConstantsOperation::KeyMessagePivotJsonGt),
+    identifierLookup(ConstantsOperation::KeyMessagePivotJsonId),
+    spsLookup(ConstantsOperation::JsonCdcSps),
+    dpsLookup(ConstantsOperation::JsonCdcDps),
+    stValLookup(ConstantsOperation::KeyMessagePivotJsonStVal),
+    qLookup(ConstantsOperation::KeyMessagePivotJsonQ)
 {
 }
 
+/**
+ * Destructor, the state of the inputs is saved in a new snapshot if it changed since the last one
+ */
+FilterOperationSp::~FilterOperationSp() {
+    lock_guard<mutex> ingestGuard(m_ingestMutex);
+    if (m_stateWriter.isOpen() && !m_restorePending && m_stateWriter.getJournalRecordCount() > 0) {
+        writeStateSnapshot();
+    }
+    // Waits until everything queued is written
+    m_stateWriter.close();
+}
+
+/**
+ * Read the input states saved in the state file when the filter was last stopped
+ * They are applied by refreshActiveConfig to the first configuration used by ingest.
+ * States older than the state_max_age option are dropped: they may not match the current value of the input anymore.
+ */
+void FilterOperationSp::restoreState() {
+    m_stateFile = m_options.stateFile;
+    m_stateWriter.setFlushInterval(m_options.stateFlushInterval);
+    uint64_t snapshotTime = 0;
+    if (!m_stateWriter.open(m_stateFile, m_restoredInputs, snapshotTime)) {
+        return;
+    }
+    if (m_options.stateMaxAge > 0) {
+        // Inputs without timestamp cannot be dated and are dropped as well
+        uint64_t oldestTimestamp = PivotTimestamp::pack(static_cast<long>(time(nullptr)) - m_options.stateMaxAge, 0);
+        std::size_t staleCount = 0;
+        for (auto it = m_restoredInputs.begin() ; it != m_restoredInputs.end() ;) {
+            if (it->second.timestamp < oldestTimestamp) {
+                it = m_restoredInputs.erase(it);
+                staleCount++;
+            }
+            else {
+                ++it;
+            }
+        }
+        if (staleCount > 0) {
+            UtilityOperation::log_warn("%s - FilterOperationSp::restoreState : %zu input states older than %ld s are ignored", ConstantsOperation::NamePlugin.c_str(),
+                                       staleCount, m_options.stateMaxAge);
+        }
+    }
+    m_restorePending = true;
+}
+
+/**
+ * Change the state file in use after a reconfiguration: the current state is written to the new file, nothing is read from it
+ * Must be called with m_ingestMutex held
+ *
+ * @param stateFile : Path of the new state file, empty to stop saving the state
+ */
+void FilterOperationSp::switchStateFile(const std::string& stateFile) {
+    m_stateWriter.close();
+    m_stateFile = stateFile;
+    if (m_stateFile.empty()) {
+        return;
+    }
+    std::unordered_map<std::string, PersistedInput> ignoredInputs;
+    uint64_t snapshotTime = 0;
+    if (m_stateWriter.open(m_stateFile, ignoredInputs, snapshotTime)) {
+        writeStateSnapshot();
+    }
+}
+
+/**
+ * Queue the changes of the input states of the last reading set for the journal, or a new snapshot
+ * when the journal grew larger than the snapshot would be
+ * Changes are collected by each ingest context and queued here, so that the workers never touch the state writer.
+ * The files are written by the thread of m_stateWriter, which flushes the journal once per state_flush_interval.
+ * Must be called with m_ingestMutex held
+ */
+void FilterOperationSp::saveState() {
+    if (!m_stateWriter.isOpen()) {
+        return;
+    }
+    StateWriter::Changes changes;
+    for (auto& context : m_ingestContexts) {
+        for (int pivotIndex : context->changedInputs) {
+            changes.emplace_back(pivotIndex, getPersistedInput(pivotIndex));
+        }
+        context->changedInputs.clear();
+    }
+    // The changes are queued even when a snapshot follows: they stay in the journal if the snapshot cannot be written
+    m_stateWriter.record(m_activeConfig, std::move(changes));
+    if (m_stateWriter.getJournalRecordCount() > std::max(SnapshotMinJournalRecords, m_activeConfig->getPivotCount())) {
+        writeStateSnapshot();
+    }
+}
+
+/**
+ * Queue a copy of every input state for a new snapshot
+ * Must be called with m_ingestMutex held
+ */
+void FilterOperationSp::writeStateSnapshot() {
+    std::vector<PersistedInput> inputs(m_inputStates.size());
+    for (std::size_t pivotIndex = 0 ; pivotIndex < inputs.size() ; pivotIndex++) {
+        inputs[pivotIndex] = getPersistedInput(static_cast<int>(pivotIndex));
+    }
+    m_stateWriter.snapshot(m_activeConfig, std::move(inputs));
+}
+
+/**
+ * State of an input as saved in the state file
+ *
+ * @param pivotIndex : Dense index of the input
+ * @return The state, quality and timestamp of the input
+ */
+PersistedInput FilterOperationSp::getPersistedInput(int pivotIndex) const {
+    PersistedInput input;
+    input.state = m_inputStates.getState(pivotIndex);
+    input.quality = m_inputStates.getQuality(pivotIndex);
+    input.timestamp = m_inputStates.getTimestamp(pivotIndex);
+    return input;
+}
+
 /**
  * Modification of configuration
+ * The new configuration is compiled without holding any lock then published under m_configMutex,
+ * ingest switches to it at the start of the next reading set.
  * 
  * @param jsonExchanged : configuration ExchangedData
 */
 void FilterOperationSp::setJsonConfig(const string& jsonExchanged) {
-    m_configOperation.importExchangedData(jsonExchanged);
-    m_cachedValues.clear();
+    std::shared_ptr<const ConfigOperation> newConfig = compileJsonConfig(jsonExchanged);
+    lock_guard<mutex> guard(m_configMutex);
+    std::atomic_store(&m_publishedConfig, newConfig);
+}
+
+/**
+ * Compile a configuration ExchangedData, without publishing it
+ * It is compared with the last published configuration so that only changed operations are rebuilt
+ *
+ * @param jsonExchanged : configuration ExchangedData
+ * @return The compiled configuration
+ */
+std::shared_ptr<const ConfigOperation> FilterOperationSp::compileJsonConfig(const string& jsonExchanged) {
+    std::shared_ptr<const ConfigOperation> previousConfig = std::atomic_load(&m_publishedConfig);
+    auto newConfig = std::make_shared<ConfigOperation>();
+    auto start = std::chrono::steady_clock::now();
+    newConfig->importExchangedData(jsonExchanged, previousConfig.get());
+    m_metrics.configLatency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    return newConfig;
+}
+
+/**
+ * Switch ingest to the published configuration if it changed since the previous reading set
+ * Input states (value, quality and timestamp) and last emitted outputs are carried over for the pivot IDs that still exist. Counters of unchanged operations
+ * are kept, the others are rebuilt from the input values.
+ * On the first switch after start, the other pivot IDs take the state restored from the state file, if any.
+ * When the published configuration was compared with the active one, the index mappings it computed
+ * are used, else pivot IDs are matched by name.
+ * The quality counts and timestamp maxima are then built or dropped if their policy changed since the previous reading set.
+ * Must be called with m_ingestMutex held
+ *
+ * @param publishedConfig : Configuration published with the options copied to m_ingestOptions
+ */
+void FilterOperationSp::refreshActiveConfig(const std::shared_ptr<const ConfigOperation>& publishedConfig) {
+    if (publishedConfig != m_activeConfig) {
+        switchActiveConfig(publishedConfig);
+    }
+    // The quality counts are only read by the worst_of and contributing policies
+    bool qualityCountsUsed = (m_ingestOptions.qualityPolicy != QualityPolicy::Trigger);
+    if (qualityCountsUsed != m_qualityCountsEnabled) {
+        rebuildQualityCounts(qualityCountsUsed);
+    }
+    // The timestamp maxima are only read by the max_of_inputs and max_of_contributing_inputs policies
+    bool timestampMaximaUsed = (m_ingestOptions.timestampPolicy != TimestampPolicy::Trigger);
+    if (timestampMaximaUsed != m_timestampMaximaEnabled) {
+        rebuildTimestampMaxima(timestampMaximaUsed);
+    }
+}
+
+/**
+ * Switch ingest to a new compiled configuration, as described in refreshActiveConfig
+ * Must be called with m_ingestMutex held
+ *
+ * @param publishedConfig : Configuration to switch to
+ */
+void FilterOperationSp::switchActiveConfig(const std::shared_ptr<const ConfigOperation>& publishedConfig) {
+    bool isDiff = (publishedConfig->getBaseGeneration() == m_activeConfig->getGeneration());
+
+    InputStateTable inputStates;
+    inputStates.reset(publishedConfig->getPivotCount());
+    std::vector<EmittedOutput> lastEmitted(publishedConfig->getPivotCount());
+    for (std::size_t pivotIndex = 0 ; pivotIndex < inputStates.size() ; pivotIndex++) {
+        int previousIndex = isDiff ? publishedConfig->getPreviousPivotIndex(static_cast<int>(pivotIndex))
+                                   : m_activeConfig->getPivotIndex(publishedConfig->getPivotId(static_cast<int>(pivotIndex)));
+        if (previousIndex >= 0) {
+            inputStates.copyInput(static_cast<int>(pivotIndex), m_inputStates, previousIndex);
+            lastEmitted[pivotIndex] = m_lastEmitted[previousIndex];
+        }
+        else if (m_restorePending) {
+            auto restoredIt = m_restoredInputs.find(publishedConfig->getPivotId(static_cast<int>(pivotIndex)));
+            if (restoredIt != m_restoredInputs.end()) {
+                inputStates.setState(static_cast<int>(pivotIndex), restoredIt->second.state);
+                inputStates.setQuality(static_cast<int>(pivotIndex), restoredIt->second.quality);
+                inputStates.setTimestamp(static_cast<int>(pivotIndex), restoredIt->second.timestamp);
+            }
+        }
+    }
+    if (m_restorePending) {
+        UtilityOperation::log_info("%s - FilterOperationSp::refreshActiveConfig : Input states restored from %s", ConstantsOperation::NamePlugin.c_str(),
+                                   m_stateFile.c_str());
+        m_restoredInputs.clear();
+        m_restorePending = false;
+    }
+
+    std::vector<uint64_t> stateCounts(publishedConfig->getCompiledOperationCount(), 0);
+    std::vector<uint32_t> unknownCounts(publishedConfig->getCompiledOperationCount(), 0);
+    QualityCounts qualityCounts;
+    if (m_qualityCountsEnabled) {
+        qualityCounts.reset(publishedConfig->getCompiledOperationCount());
+    }
+    TimestampMaxima timestampMaxima;
+    if (m_timestampMaximaEnabled) {
+        timestampMaxima.reset(publishedConfig->getCompiledOperationCount());
+    }
+    OperationStatsTable operationStats;
+    operationStats.reset(publishedConfig->getCompiledOperationCount());
+    for (std::size_t operationIndex = 0 ; operationIndex < stateCounts.size() ; operationIndex++) {
+        int previousIndex = isDiff ? publishedConfig->getPreviousOperationIndex(static_cast<int>(operationIndex)) : -1;
+        if (previousIndex >= 0) {
+            stateCounts[operationIndex] = m_stateCounts[previousIndex];
+            unknownCounts[operationIndex] = m_unknownCounts[previousIndex];
+            if (m_qualityCountsEnabled) {
+                qualityCounts.copyOperation(static_cast<int>(operationIndex), m_qualityCounts, previousIndex);
+            }
+            if (m_timestampMaximaEnabled) {
+                timestampMaxima.copyOperation(static_cast<int>(operationIndex), m_timestampMaxima, previousIndex);
+            }
+            operationStats.copyOperation(static_cast<int>(operationIndex), m_operationStats, previousIndex);
+            continue;
+        }
+        const CompiledOperation& operation = publishedConfig->getCompiledOperation(static_cast<int>(operationIndex));
+        for (int inputPivotIndex : publishedConfig->getOperationInputs(operation)) {
+            int state = inputStates.getValue(inputPivotIndex);
+            stateCounts[operationIndex] += StateCounts::unit(state);
+            if (!inputStates.isKnown(inputPivotIndex)) {
+                unknownCounts[operationIndex]++;
+            }
+            if (m_qualityCountsEnabled) {
+                qualityCounts.add(static_cast<int>(operationIndex), state, inputStates.getQuality(inputPivotIndex));
+            }
+            if (m_timestampMaximaEnabled) {
+                timestampMaxima.add(static_cast<int>(operationIndex), state, inputStates.getTimestamp(inputPivotIndex));
+            }
+        }
+    }
+
+    m_inputStates.swap(inputStates);
+    m_stateCounts.swap(stateCounts);
+    m_unknownCounts.swap(unknownCounts);
+    m_qualityCounts.swap(qualityCounts);
+    m_timestampMaxima.swap(timestampMaxima);
+    m_operationStats.swap(operationStats);
+    m_lastEmitted.swap(lastEmitted);
+    m_pendingOperationIndexes.assign(publishedConfig->getCompiledOperationCount(), -1);
+    m_scheduledOperations.assign(publishedConfig->getCompiledOperationCount(), 0);
+    for (auto& context : m_ingestContexts) {
+        context->chainBuckets.assign(publishedConfig->getChainLevelCount(), std::vector<CompiledLookup>());
+    }
+    m_activeConfig = publishedConfig;
+}
+
+/**
+ * Build the quality counts of every operation from the last known quality of its inputs, or free them.
+ * Qualities are not decoded while no option uses them, those inputs count with their quality before that until their next reading
+ * Must be called with m_ingestMutex held
+ *
+ * @param enabled : true to build the counts and maintain them for the next readings, false to free them
+ */
+void FilterOperationSp::rebuildQualityCounts(bool enabled) {
+    QualityCounts qualityCounts;
+    if (enabled) {
+        qualityCounts.reset(m_activeConfig->getCompiledOperationCount());
+        for (std::size_t operationIndex = 0 ; operationIndex < m_activeConfig->getCompiledOperationCount() ; operationIndex++) {
+            const CompiledOperation& operation = m_activeConfig->getCompiledOperation(static_cast<int>(operationIndex));
+            for (int inputPivotIndex : m_activeConfig->getOperationInputs(operation)) {
+                qualityCounts.add(static_cast<int>(operationIndex), m_inputStates.getValue(inputPivotIndex), m_inputStates.getQuality(inputPivotIndex));
+            }
+        }
+    }
+    m_qualityCounts.swap(qualityCounts);
+    m_qualityCountsEnabled = enabled;
+}
+
+/**
+ * Build the timestamp maxima of every operation from the last known timestamp of its inputs, or free them.
+ * Timestamps are not read while no option uses them, those inputs count with their timestamp before that until their next reading
+ * Must be called with m_ingestMutex held
+ *
+ * @param enabled : true to build the maxima and maintain them for the next readings, false to free them
+ */
+void FilterOperationSp::rebuildTimestampMaxima(bool enabled) {
+    TimestampMaxima timestampMaxima;
+    if (enabled) {
+        timestampMaxima.reset(m_activeConfig->getCompiledOperationCount());
+        for (std::size_t operationIndex = 0 ; operationIndex < m_activeConfig->getCompiledOperationCount() ; operationIndex++) {
+            const CompiledOperation& operation = m_activeConfig->getCompiledOperation(static_cast<int>(operationIndex));
+            for (int inputPivotIndex : m_activeConfig->getOperationInputs(operation)) {
+                timestampMaxima.add(static_cast<int>(operationIndex), m_inputStates.getValue(inputPivotIndex), m_inputStates.getTimestamp(inputPivotIndex));
+            }
+        }
+    }
+    m_timestampMaxima.swap(timestampMaxima);
+    m_timestampMaximaEnabled = enabled;
 }
 
 /**
@@ -55,34 +384,99 @@ void FilterOperationSp::setJsonConfig(const string& jsonExchanged) {
  */
 void FilterOperationSp::ingest(READINGSET *readingSet) 
 {
-    lock_guard<mutex> guard(m_configMutex);
-    std::string beforeLog = ConstantsOperation::NamePlugin + " - FilterOperationSp::ingest :";
+    // Time spent waiting for the previous reading set is part of the latency added by the filter
+    auto start = std::chrono::steady_clock::now();
+    lock_guard<mutex> ingestGuard(m_ingestMutex);
     std::vector<Reading*> vectorReadingOperation;
 	
     if (!readingSet) {
-        UtilityOperation::log_error("%s No reading set provided", beforeLog.c_str());
+        UtilityOperation::log_error("%s - FilterOperationSp::ingest : No reading set provided", ConstantsOperation::NamePlugin.c_str());
         return;
     } 
     if (m_func == nullptr) {
-        UtilityOperation::log_error("%s No callback function defined", beforeLog.c_str());
+        UtilityOperation::log_error("%s - FilterOperationSp::ingest : No callback function defined", ConstantsOperation::NamePlugin.c_str());
         return;
     }
 
-    if (isEnabled()) { 
+    bool enabled = false;
+    std::shared_ptr<const ConfigOperation> publishedConfig;
+    {
+        // The options and the configuration are published together by reconfigure
+        lock_guard<mutex> guard(m_configMutex);
+        enabled = isEnabled();
+        m_ingestOptions = m_options;
+        publishedConfig = m_publishedConfig;
+    }
+
+    if (enabled) { 
+        refreshActiveConfig(publishedConfig);
+        m_stateWriter.setFlushInterval(m_ingestOptions.stateFlushInterval);
+        if (m_ingestOptions.stateFile != m_stateFile) {
+            switchStateFile(m_ingestOptions.stateFile);
+        }
+        m_readInputQualities = m_qualityCountsEnabled || m_ingestOptions.emitPolicy == EmitPolicy::OnChangeOrQualityChange
+                               || m_ingestOptions.unknownInputPolicy == UnknownInputPolicy::Questionable || m_stateWriter.isOpen();
+        m_readInputTimestamps = m_timestampMaximaEnabled || m_ingestOptions.rejectOutOfOrder || m_ingestOptions.coalesceOutputs
+                                || m_stateWriter.isOpen();
+        updateWorkerPool(m_ingestOptions.workerThreads > 1 ? static_cast<std::size_t>(m_ingestOptions.workerThreads) : 1);
         // Just get all the readings in the readingset
         std::vector<Reading*>* readings = readingSet->getAllReadingsPtr();
-        auto readIt = readings->begin();
-        while(readIt != readings->end()) {
-            Reading* reading = *readIt;
-            bool deleteInput = processReading(reading, vectorReadingOperation);
-            // If input TI is one of the output TIs, remove the original input reading as a new value for it was already generated
-            if (deleteInput) {
-                readIt = readings->erase(readIt);
+        std::size_t readingCount = readings->size();
+        m_metrics.add(MetricCounter::ReadingsIn, readingCount);
+        // Readings matching no operation generate nothing: the estimate is capped so that a large fan-out does not reserve
+        // memory for every reading of a large batch, the vector still grows past it if needed
+        vectorReadingOperation.reserve(readingCount * std::min(m_activeConfig->getFanOutEstimate(), MaxReservedFanOut));
+        // Readings are compacted in a single stable pass: kept readings are moved down over the removed ones
+        auto writeIt = readings->begin();
+        if (m_ingestOptions.coalesceOutputs) {
+            // Removed readings are still referenced by the pending operations, they are deleted once the outputs are generated
+            std::vector<Reading*> removedReadings;
+            for (auto readIt = readings->begin() ; readIt != readings->end() ; ++readIt) {
+                Reading* reading = *readIt;
+                if (coalesceReading(reading)) {
+                    removedReadings.push_back(reading);
+                }
+                else {
+                    *writeIt++ = reading;
+                }
             }
-            else {
-                readIt++;
+            readings->erase(writeIt, readings->end());
+            generatePendingOperations(vectorReadingOperation);
+            for (Reading* reading : removedReadings) {
+                delete reading;
+            }
+        }
+        else if (m_workerPool && readings->size() >= ParallelMinReadings && m_activeConfig->getComponentCount() > 1) {
+            processReadingsInParallel(*readings, vectorReadingOperation);
+        }
+        else {
+            IngestContext& context = *m_ingestContexts[0];
+            for (auto readIt = readings->begin() ; readIt != readings->end() ; ++readIt) {
+                Reading* reading = *readIt;
+                bool deleteInput = processReading(context, reading, vectorReadingOperation);
+                // If input TI is one of the output TIs and its reading could not be rewritten in place, remove the original input reading
+                if (deleteInput) {
+                    delete reading;
+                }
+                else {
+                    *writeIt++ = reading;
+                }
             }
+            readings->erase(writeIt, readings->end());
+        }
+        m_metrics.add(MetricCounter::InputsDeleted, readingCount - readings->size());
+        saveState();
+        for (auto& context : m_ingestContexts) {
+            m_metrics.add(context->metricCounts);
+        }
+        auto end = std::chrono::steady_clock::now();
+        m_metrics.ingestLatency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        // The first reading set processed sends the metrics as well
+        if (m_ingestOptions.metricsInterval > 0 && (m_lastMetricsTime == std::chrono::steady_clock::time_point()
+                                                    || end - m_lastMetricsTime >= std::chrono::seconds(m_ingestOptions.metricsInterval))) {
+            vectorReadingOperation.push_back(generateMetricsReading(end));
         }
+        readings->reserve(readings->size() + vectorReadingOperation.size());
         readingSet->append(vectorReadingOperation);
     }
 
@@ -90,200 +484,918 @@ void FilterOperationSp::ingest(READINGSET *readingSet)
 }
 
 /**
- * Apply filter for the given rading
+ * Create or remove the worker pool when the worker_threads option changed, with one ingest context per worker
+ * Must be called with m_ingestMutex held
  *
- * @param reading The reading to filter
+ * @param workerCount : Number of workers, including the ingest thread, 1 to process all the readings in the ingest thread
+ */
+void FilterOperationSp::updateWorkerPool(std::size_t workerCount) {
+    if (m_ingestContexts.size() == workerCount) {
+        return;
+    }
+    m_workerPool.reset();
+    // Contexts are only resized between reading sets, when their changed inputs were already saved
+    m_ingestContexts.resize(workerCount);
+    for (auto& context : m_ingestContexts) {
+        if (!context) {
+            context.reset(new IngestContext);
+            context->chainBuckets.assign(m_activeConfig->getChainLevelCount(), std::vector<CompiledLookup>());
+        }
+    }
+    if (workerCount > 1) {
+        m_workerPool.reset(new WorkerPool(workerCount));
+        UtilityOperation::log_info("%s - FilterOperationSp::updateWorkerPool : %zu worker threads started", ConstantsOperation::NamePlugin.c_str(), workerCount);
+    }
+}
+
+/**
+ * Process the readings of a reading set on the worker pool
+ * Inputs are first read in parallel by contiguous chunks. The readings are then dealt to tasks by connected component
+ * of their input, each task processing its readings in their original order: the operations of a component are only
+ * affected by the readings of this component, so the outputs are the same as with a sequential processing.
+ * Generated readings are finally merged in the order of the input readings they were generated from.
+ * Must be called with m_ingestMutex held
+ *
+ * @param readings The readings of the reading set, compacted when input readings are deleted
  * @param out_vectorReadingOperation Out parameter storing all generated readings
- * @return true if the input reading should be deleted, else false
  */
-bool FilterOperationSp::processReading(Reading* reading, std::vector<Reading*>& out_vectorReadingOperation) {
+void FilterOperationSp::processReadingsInParallel(std::vector<Reading*>& readings, std::vector<Reading*>& out_vectorReadingOperation) {
+    std::size_t readingCount = readings.size();
+    std::size_t workerCount = m_workerPool->getWorkerCount();
+
+    // The pivot index stays -1 for the readings not involved in operations
+    std::vector<InputReading> inputReadings(readingCount);
+    std::size_t chunkCount = std::min(readingCount, workerCount * TasksPerWorker);
+    m_workerPool->run(chunkCount, [&](std::size_t chunk, std::size_t worker) {
+        IngestContext& context = *m_ingestContexts[worker];
+        std::size_t end = readingCount * (chunk + 1) / chunkCount;
+        for (std::size_t i = readingCount * chunk / chunkCount ; i < end ; i++) {
+            readInput(context, readings[i], inputReadings[i]);
+        }
+    });
+
+    std::size_t taskCount = std::min(m_activeConfig->getComponentCount(), workerCount * TasksPerWorker);
+    std::vector<std::vector<std::size_t>> taskReadings(taskCount);
+    for (std::size_t i = 0 ; i < readingCount ; i++) {
+        if (inputReadings[i].pivotIndex >= 0) {
+            taskReadings[m_activeConfig->getComponent(inputReadings[i].pivotIndex) % taskCount].push_back(i);
+        }
+    }
+
+    std::vector<std::vector<Reading*>> generatedReadings(readingCount);
+    std::vector<uint8_t> deleteInputs(readingCount, 0);
+    m_workerPool->run(taskCount, [&](std::size_t task, std::size_t worker) {
+        IngestContext& context = *m_ingestContexts[worker];
+        for (std::size_t i : taskReadings[task]) {
+            deleteInputs[i] = processInput(context, readings[i], inputReadings[i], generatedReadings[i]);
+        }
+    });
+
+    auto writeIt = readings.begin();
+    for (std::size_t i = 0 ; i < readingCount ; i++) {
+        out_vectorReadingOperation.insert(out_vectorReadingOperation.end(), generatedReadings[i].begin(), generatedReadings[i].end());
+        // If input TI is one of the output TIs and its reading could not be rewritten in place, remove the original input reading
+        if (deleteInputs[i]) {
+            delete readings[i];
+        }
+        else {
+            *writeIt++ = readings[i];
+        }
+    }
+    readings.erase(writeIt, readings.end());
+}
+
+/**
+ * Generate the reading of the metrics of the filter, sent with the reading set being processed
+ * Must be called with m_ingestMutex held
+ *
+ * @param now Time of the end of the processing of the reading set
+ * @return A new reading holding the counters and the latency histograms since the filter was started
+ */
+Reading* FilterOperationSp::generateMetricsReading(std::chrono::steady_clock::time_point now) {
+    m_lastMetricsTime = now;
+    Datapoint* metrics = m_metrics.toDatapoint(ConstantsOperation::KeyMetrics);
+    if (m_ingestOptions.operationStats) {
+        createStringElement(metrics->getData().getDpVec(), ConstantsOperation::KeyMetricsTopOperations, buildOperationStatsReport(MetricsTopOperations));
+    }
+    return new Reading(m_ingestOptions.metricsAsset, metrics);
+}
+
+/**
+ * Statistics of the operations of each output, as a JSON document listing the outputs from the most to the least expensive to evaluate
+ * Statistics of unchanged operations are kept on reconfiguration, the others start from zero
+ *
+ * @param topCount Maximum number of outputs listed, 0 to list them all
+ * @return The JSON document, with no output when the operation_stats option was never enabled
+ */
+std::string FilterOperationSp::getOperationStatsReport(std::size_t topCount) {
+    lock_guard<mutex> ingestGuard(m_ingestMutex);
+    return buildOperationStatsReport(topCount);
+}
+
+/**
+ * Build the report returned by getOperationStatsReport
+ * Must be called with m_ingestMutex held
+ *
+ * @param topCount Maximum number of outputs listed, 0 to list them all
+ * @return The JSON document
+ */
+std::string FilterOperationSp::buildOperationStatsReport(std::size_t topCount) const {
+    struct OutputStats {
+        int outputIndex = 0;
+        std::size_t inputCount = 0;
+        OperationStats stats;
+    };
+    std::vector<OutputStats> outputs;
+    for (std::size_t outputIndex = 0 ; outputIndex < m_activeConfig->getCompiledOutputCount() ; outputIndex++) {
+        const CompiledOutput& compiledOutput = m_activeConfig->getCompiledOutput(static_cast<int>(outputIndex));
+        OutputStats output;
+        output.outputIndex = static_cast<int>(outputIndex);
+        for (int operationIndex = compiledOutput.operationBegin ; operationIndex < compiledOutput.operationEnd ; operationIndex++) {
+            const CompiledOperation& operation = m_activeConfig->getCompiledOperation(operationIndex);
+            output.inputCount += operation.inputEnd - operation.inputBegin;
+            output.stats.add(m_operationStats.get(operationIndex));
+        }
+        if (output.stats.evaluations > 0 || output.stats.suppressed > 0) {
+            outputs.push_back(output);
+        }
+    }
+    std::sort(outputs.begin(), outputs.end(), [](const OutputStats& left, const OutputStats& right) {
+        if (left.stats.processingTime != right.stats.processingTime) {
+            return left.stats.processingTime > right.stats.processingTime;
+        }
+        return left.stats.evaluations > right.stats.evaluations;
+    });
+    if (topCount > 0 && outputs.size() > topCount) {
+        outputs.resize(topCount);
+    }
+
+    std::string report = "{\"operations\":[";
+    for (std::size_t i = 0 ; i < outputs.size() ; i++) {
+        const OutputStats& output = outputs[i];
+        const CompiledOutput& compiledOutput = m_activeConfig->getCompiledOutput(output.outputIndex);
+        uint64_t averageTime = output.stats.evaluations == 0 ? 0 : output.stats.processingTime / output.stats.evaluations;
+        if (i > 0) {
+            report += ",";
+        }
+        report += "{\"pivot_id\":\"" + UtilityOperation::escapeJson(m_activeConfig->getPivotId(compiledOutput.pivotIndex)) + "\""
+                  ",\"inputs\":" + std::to_string(output.inputCount) +
+                  ",\"evaluations\":" + std::to_string(output.stats.evaluations) +
+                  ",\"emitted\":" + std::to_string(output.stats.emitted) +
+                  ",\"suppressed\":" + std::to_string(output.stats.suppressed) +
+                  ",\"average_processing_ns\":" + std::to_string(averageTime) +
+                  ",\"total_processing_ns\":" + std::to_string(output.stats.processingTime) + "}";
+    }
+    report += "]}";
+    return report;
+}
+
+/**
+ * Read the pivot ID, value, quality and timestamp of an input reading involved in operations
+ *
+ * @param context Ingest context of the calling thread
+ * @param reading The reading to read
+ * @param out_input Out parameter storing the input read
+ * @return true if the reading is an input of operations, false if it must be forwarded unchanged
+ */
+bool FilterOperationSp::readInput(IngestContext& context, Reading* reading, InputReading& out_input) {
     // Get datapoints on readings
     Datapoints &dataPoints = reading->getReadingData();
-    string assetName = reading->getAssetName();
-
-    string beforeLog = ConstantsOperation::NamePlugin + " - " + assetName + " - FilterOperationSp::processReading :";
+    // Log prefix is given as format arguments so that nothing is built when debug logs are disabled
+    const string& assetName = reading->getAssetName();
 
-    Datapoints *dpPivotTS = findDictElement(&dataPoints, ConstantsOperation::KeyMessagePivotJsonRoot);
+    Datapoints *dpPivotTS = context.pivotLookup.findDict(&dataPoints);
     if (dpPivotTS == nullptr) {
-        UtilityOperation::log_debug("%s Missing %s attribute, it is ignored", beforeLog.c_str(), ConstantsOperation::KeyMessagePivotJsonRoot.c_str());
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::readInput : Missing %s attribute, it is ignored", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), ConstantsOperation::KeyMessagePivotJsonRoot.c_str());
+        context.metricCounts.add(MetricCounter::IgnoredMissingPivot);
         return false;
     }
 
-    Datapoints *dpGtis = findDictElement(dpPivotTS, ConstantsOperation::KeyMessagePivotJsonGt);
+    Datapoints *dpGtis = context.gtisLookup.findDict(dpPivotTS);
     if (dpGtis == nullptr) {
-        UtilityOperation::log_debug("%s Missing %s attribute, it is ignored", beforeLog.c_str(), ConstantsOperation::KeyMessagePivotJsonGt.c_str());
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::readInput : Missing %s attribute, it is ignored", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), ConstantsOperation::KeyMessagePivotJsonGt.c_str());
+        context.metricCounts.add(MetricCounter::IgnoredMissingGtis);
        return false;
     }
 
-    string inputPivotId = findStringElement(dpGtis, ConstantsOperation::KeyMessagePivotJsonId);
-    if (inputPivotId.compare("") == 0) {
-        UtilityOperation::log_debug("%s Missing %s attribute, it is ignored", beforeLog.c_str(), ConstantsOperation::KeyMessagePivotJsonId.c_str());
+    const DatapointValue *valueId = context.identifierLookup.findValue(dpGtis);
+    string inputPivotId;
+    if (valueId != nullptr && valueId->getType() == DatapointValue::T_STRING) {
+        inputPivotId = valueId->toStringValue();
+    }
+    if (inputPivotId.empty()) {
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::readInput : Missing %s attribute, it is ignored", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), ConstantsOperation::KeyMessagePivotJsonId.c_str());
+        context.metricCounts.add(MetricCounter::IgnoredMissingIdentifier);
         return false;
     }
 
-    const auto& operationsLookup = m_configOperation.getOperationsForInputId(inputPivotId);
+    int inputPivotIndex = m_activeConfig->getPivotIndex(inputPivotId);
+    const auto& operationsLookup = m_activeConfig->getCompiledOperationsForInput(inputPivotIndex);
     if (operationsLookup.empty()) {
-        UtilityOperation::log_debug("%s No operation configured for Pivot ID %s", beforeLog.c_str(), inputPivotId.c_str());
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::readInput : No operation configured for Pivot ID %s", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), inputPivotId.c_str());
+        context.metricCounts.add(MetricCounter::IgnoredNoOperation);
         return false;
     }
 
     bool typeSps = true;
-    Datapoints *dpTyp = findDictElement(dpGtis, ConstantsOperation::JsonCdcSps);
+    Datapoints *dpTyp = context.spsLookup.findDict(dpGtis);
     if (dpTyp == nullptr) {
-        dpTyp = findDictElement(dpGtis, ConstantsOperation::JsonCdcDps);
+        dpTyp = context.dpsLookup.findDict(dpGtis);
         
         if (dpTyp == nullptr) {
-            UtilityOperation::log_debug("%s Missing CDC (%s and %s missing) attribute, it is ignored", beforeLog.c_str(), ConstantsOperation::JsonCdcSps.c_str(), ConstantsOperation::JsonCdcDps.c_str());
+            SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::readInput : Missing CDC (%s and %s missing) attribute, it is ignored", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), ConstantsOperation::JsonCdcSps.c_str(), ConstantsOperation::JsonCdcDps.c_str());
+            context.metricCounts.add(MetricCounter::IgnoredMissingCdc);
             return false;
         }
         typeSps = false;
     }            
 
-    const DatapointValue *valueTS = findValueElement(dpTyp, ConstantsOperation::KeyMessagePivotJsonStVal);
+    const DatapointValue *valueTS = context.stValLookup.findValue(dpTyp);
     if (valueTS == nullptr) {
-        UtilityOperation::log_debug("%s Missing %s attribute, it is ignored", beforeLog.c_str(), ConstantsOperation::KeyMessagePivotJsonStVal.c_str());
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::readInput : Missing %s attribute, it is ignored", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), ConstantsOperation::KeyMessagePivotJsonStVal.c_str());
+        context.metricCounts.add(MetricCounter::IgnoredMissingStVal);
         return false;
     }
 
-    int newValue = 0;
+    int newValue = PointState::StateOff;
     if (typeSps) {
-        newValue = static_cast<int>(valueTS->toInt());
+        newValue = valueTS->toInt() != 0 ? PointState::StateOn : PointState::StateOff;
     }
     else {
-        newValue = valueTS->toStringValue() == "on" ? 1 : 0;
+        newValue = PointState::decodeDps(valueTS->toStringValue());
+    }
+
+    out_input.pivotIndex = inputPivotIndex;
+    out_input.value = newValue;
+    // The quality and timestamp are only decoded when used, else the input keeps its last known ones
+    out_input.quality = m_readInputQualities ? PivotQuality::encode(context.qLookup.findDict(dpTyp)) : m_inputStates.getQuality(inputPivotIndex);
+    out_input.timestamp = m_readInputTimestamps ? PivotTimestamp::read(dpTyp) : m_inputStates.getTimestamp(inputPivotIndex);
+    out_input.view.pivot = dpPivotTS;
+    out_input.view.gtis = dpGtis;
+    out_input.view.cdc = dpTyp;
+    context.metricCounts.add(MetricCounter::ReadingsMatched);
+    return true;
+}
+
+/**
+ * Apply filter for the given rading
+ *
+ * @param context Ingest context of the calling thread
+ * @param reading The reading to filter
+ * @param out_vectorReadingOperation Out parameter storing all generated readings
+ * @return true if the input reading should be deleted, else false
+ */
+bool FilterOperationSp::processReading(IngestContext& context, Reading* reading, std::vector<Reading*>& out_vectorReadingOperation) {
+    InputReading inputReading;
+    if (!readInput(context, reading, inputReading)) {
+        return false;
+    }
+    return processInput(context, reading, inputReading, out_vectorReadingOperation);
+}
+
+/**
+ * Update the operations of an input reading and generate their outputs
+ * When the input is one of the outputs of its operations, its reading is rewritten in place with the output value.
+ * When an output is chained, its computed value is fed to the operations using it, which are evaluated
+ * after all the outputs of lower chain levels so that each one is evaluated once with its final inputs
+ *
+ * @param context Ingest context of the calling thread
+ * @param reading The reading to filter
+ * @param inputReading The input read from the reading by readInput
+ * @param out_vectorReadingOperation Out parameter storing all generated readings
+ * @return true if the input reading should be deleted, else false
+ */
+bool FilterOperationSp::processInput(IngestContext& context, Reading* reading, const InputReading& inputReading, std::vector<Reading*>& out_vectorReadingOperation) {
+    // Log prefix is given as format arguments so that nothing is built when debug logs are disabled
+    const string& assetName = reading->getAssetName();
+    if (isOutOfOrder(inputReading)) {
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::processReading : Reading older than the last one of %s, it is ignored", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(),
+                              m_activeConfig->getPivotId(inputReading.pivotIndex).c_str());
+        context.metricCounts.add(MetricCounter::IgnoredOutOfOrder);
+        // An old value of a computed output must not be forwarded either
+        return isOwnOutput(inputReading.pivotIndex);
+    }
+    updateMeasuredValue(context, inputReading);
+
+    int inputPivotIndex = inputReading.pivotIndex;
+    const PivotReadingView& input = inputReading.view;
+    int chainLevelCount = m_activeConfig->getChainLevelCount();
+    if (chainLevelCount > 1) {
+        scheduleOperations(context, inputPivotIndex);
     }
 
     bool inputIsInOutputs = false;
-    for(const auto& operationLookup: operationsLookup) {
-        m_cachedValues[inputPivotId] = newValue;
-        Reading* newReading = generateReadingOperation(reading, operationLookup.outputPivotId, operationLookup.operationIndex);
-        if (newReading != nullptr){
-            UtilityOperation::log_debug("%s Generation of the reading [%s]", beforeLog.c_str(), newReading->toJSON().c_str());
-            out_vectorReadingOperation.push_back(newReading);
-            // Only delete input reading if a replacement was generated
-            if (inputPivotId == operationLookup.outputPivotId) {
-                inputIsInOutputs = true;
+    // Operation of the input itself, whose reading is rewritten in place once all other outputs are generated from it
+    int inPlaceOperationIndex = -1;
+    int inPlaceValue = 0;
+    OutputAttributes inPlaceAttributes;
+    for (int level = 0 ; level < chainLevelCount ; level++) {
+        // Without chained outputs, the operations of the input are evaluated directly from the lookup table
+        ConstSpan<CompiledLookup> operationsLookup = m_activeConfig->getCompiledOperationsForInput(inputPivotIndex);
+        if (chainLevelCount > 1) {
+            const std::vector<CompiledLookup>& bucket = context.chainBuckets[level];
+            operationsLookup = ConstSpan<CompiledLookup>(bucket.data(), bucket.data() + bucket.size());
+        }
+        for(const auto& operationLookup: operationsLookup) {
+            OperationTimer timer(m_ingestOptions.operationStats ? &m_operationStats : nullptr, operationLookup.compiledOperationIndex);
+            if (m_ingestOptions.unknownInputPolicy == UnknownInputPolicy::Withhold && hasTooManyUnknownInputs(operationLookup.compiledOperationIndex)) {
+                SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::processReading : Output %s withheld, too many of its inputs are unknown", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(),
+                                      m_activeConfig->getPivotId(operationLookup.outputPivotIndex).c_str());
+                countOutput(context, operationLookup.compiledOperationIndex, false);
+                // No output replaces the input reading, it is kept unchanged
+                continue;
+            }
+            int outputValue = measureOperation(operationLookup.compiledOperationIndex);
+            OutputAttributes outputAttributes = computeOutputAttributes(operationLookup.compiledOperationIndex, outputValue, inputReading.quality);
+            if (!isOutputChanged(operationLookup.outputPivotIndex, outputValue, outputAttributes.quality)) {
+                SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::processReading : Output %s unchanged, no reading generated", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(),
+                                      m_activeConfig->getPivotId(operationLookup.outputPivotIndex).c_str());
+                countOutput(context, operationLookup.compiledOperationIndex, false);
+                // The input reading carries a value for an output that must not change, it is removed as well
+                if (inputPivotIndex == operationLookup.outputPivotIndex) {
+                    inputIsInOutputs = true;
+                }
+                continue;
+            }
+            if (inputPivotIndex == operationLookup.outputPivotIndex && inPlaceOperationIndex < 0) {
+                inPlaceOperationIndex = operationLookup.compiledOperationIndex;
+                inPlaceValue = outputValue;
+                inPlaceAttributes = outputAttributes;
+                continue;
+            }
+            Reading* newReading = generateReadingOperation(input, operationLookup.compiledOperationIndex, outputValue, outputAttributes);
+            if (newReading != nullptr){
+                SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::processReading : Generation of the reading [%s]", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), newReading->toJSON().c_str());
+                out_vectorReadingOperation.push_back(newReading);
+                countOutput(context, operationLookup.compiledOperationIndex, true);
+                recordEmittedOutput(operationLookup.outputPivotIndex, outputValue, outputAttributes.quality);
+                // Only delete input reading if a replacement was generated
+                if (inputPivotIndex == operationLookup.outputPivotIndex) {
+                    inputIsInOutputs = true;
+                }
+                if (propagateOutput(context, operationLookup.compiledOperationIndex, outputValue, outputAttributes, inputReading.timestamp)) {
+                    scheduleOperations(context, operationLookup.outputPivotIndex);
+                }
+            }
+        }
+        if (chainLevelCount > 1) {
+            for (const auto& operationLookup: context.chainBuckets[level]) {
+                m_scheduledOperations[operationLookup.compiledOperationIndex] = 0;
+            }
+            context.chainBuckets[level].clear();
+        }
+    }
+
+    if (inPlaceOperationIndex >= 0) {
+        OperationTimer timer(m_ingestOptions.operationStats ? &m_operationStats : nullptr, inPlaceOperationIndex);
+        const CompiledOperation& compiledOperation = m_activeConfig->getCompiledOperation(inPlaceOperationIndex);
+        const CompiledOutput& compiledOutput = m_activeConfig->getCompiledOutput(compiledOperation.outputIndex);
+        if (compiledOutput.readingTemplate->rewrite(inPlaceValue, input, inPlaceAttributes)) {
+            if (assetName != compiledOutput.assetName) {
+                reading->setAssetName(compiledOutput.assetName);
             }
+            SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::processReading : Reading rewritten in place [%s]", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), reading->toJSON().c_str());
+            recordEmittedOutput(inputPivotIndex, inPlaceValue, inPlaceAttributes.quality);
+            countOutput(context, inPlaceOperationIndex, true);
+            // The input reading now holds the output value, it stays at its position in the reading set
+            return false;
         }
+        Reading* newReading = generateReadingOperation(input, inPlaceOperationIndex, inPlaceValue, inPlaceAttributes);
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::processReading : Generation of the reading [%s]", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), newReading->toJSON().c_str());
+        out_vectorReadingOperation.push_back(newReading);
+        countOutput(context, inPlaceOperationIndex, true);
+        recordEmittedOutput(inputPivotIndex, inPlaceValue, inPlaceAttributes.quality);
+        inputIsInOutputs = true;
     }
     return inputIsInOutputs;
 }
 
+/**
+ * Take into account an input reading of a coalesced reading set
+ * The value of the input is stored and the operations using it are marked as pending, with the reading
+ * having the newest timestamp as source of their output. Outputs are generated by generatePendingOperations
+ *
+ * @param reading The reading to filter
+ * @return true if the input reading should be deleted, else false
+ */
+bool FilterOperationSp::coalesceReading(Reading* reading) {
+    // Coalesced reading sets are always processed by the ingest thread
+    IngestContext& context = *m_ingestContexts[0];
+    InputReading inputReading;
+    if (!readInput(context, reading, inputReading)) {
+        return false;
+    }
+    if (isOutOfOrder(inputReading)) {
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::coalesceReading : Reading older than the last one of %s, it is ignored", ConstantsOperation::NamePlugin.c_str(),
+                              reading->getAssetName().c_str(), m_activeConfig->getPivotId(inputReading.pivotIndex).c_str());
+        context.metricCounts.add(MetricCounter::IgnoredOutOfOrder);
+        return isOwnOutput(inputReading.pivotIndex);
+    }
+    updateMeasuredValue(context, inputReading);
+
+    bool inputIsInOutputs = false;
+    for(const auto& operationLookup: m_activeConfig->getCompiledOperationsForInput(inputReading.pivotIndex)) {
+        addPendingOperation(operationLookup, inputReading.view, inputReading.timestamp, inputReading.quality);
+        // The value of the input is replaced by the coalesced output
+        if (inputReading.pivotIndex == operationLookup.outputPivotIndex) {
+            inputIsInOutputs = true;
+        }
+    }
+    return inputIsInOutputs;
+}
+
+/**
+ * Mark an operation as pending in a coalesced reading set, the source of its output being the reading with the newest timestamp
+ *
+ * @param operationLookup operation to mark and its output
+ * @param source elements of the reading used to build the output
+ * @param sourceTimestamp timestamp of the reading
+ * @param sourceQuality quality of the reading
+ */
+void FilterOperationSp::addPendingOperation(const CompiledLookup& operationLookup, const PivotReadingView& source, uint64_t sourceTimestamp, uint16_t sourceQuality) {
+    int& pendingIndex = m_pendingOperationIndexes[operationLookup.compiledOperationIndex];
+    if (pendingIndex < 0) {
+        pendingIndex = static_cast<int>(m_pendingOperations.size());
+        m_pendingOperations.emplace_back();
+        PendingOperation& pendingOperation = m_pendingOperations.back();
+        pendingOperation.compiledOperationIndex = operationLookup.compiledOperationIndex;
+        pendingOperation.outputPivotIndex = operationLookup.outputPivotIndex;
+        pendingOperation.source = source;
+        pendingOperation.sourceTimestamp = sourceTimestamp;
+        pendingOperation.sourceQuality = sourceQuality;
+    }
+    else if (sourceTimestamp >= m_pendingOperations[pendingIndex].sourceTimestamp) {
+        m_pendingOperations[pendingIndex].source = source;
+        m_pendingOperations[pendingIndex].sourceTimestamp = sourceTimestamp;
+        m_pendingOperations[pendingIndex].sourceQuality = sourceQuality;
+    }
+}
+
+/**
+ * Generate the outputs of the operations affected by a coalesced reading set, from the final values of their inputs
+ * With chained outputs, operations are evaluated by chain level and the ones using a chained output become pending as well
+ *
+ * @param out_vectorReadingOperation Out parameter storing all generated readings
+ */
+void FilterOperationSp::generatePendingOperations(std::vector<Reading*>& out_vectorReadingOperation) {
+    IngestContext& context = *m_ingestContexts[0];
+    int chainLevelCount = m_activeConfig->getChainLevelCount();
+    for (int level = 0 ; level < chainLevelCount ; level++) {
+        // Chained outputs add pending operations of higher levels while the list is iterated
+        for (std::size_t i = 0 ; i < m_pendingOperations.size() ; i++) {
+            if (chainLevelCount > 1 && m_activeConfig->getChainLevel(m_pendingOperations[i].compiledOperationIndex) != level) {
+                continue;
+            }
+            PendingOperation pendingOperation = m_pendingOperations[i];
+            m_pendingOperationIndexes[pendingOperation.compiledOperationIndex] = -1;
+            OperationTimer timer(m_ingestOptions.operationStats ? &m_operationStats : nullptr, pendingOperation.compiledOperationIndex);
+            if (m_ingestOptions.unknownInputPolicy == UnknownInputPolicy::Withhold && hasTooManyUnknownInputs(pendingOperation.compiledOperationIndex)) {
+                SPOPERATORS_LOG_DEBUG("%s - FilterOperationSp::generatePendingOperations : Output %s withheld, too many of its inputs are unknown", ConstantsOperation::NamePlugin.c_str(),
+                                      m_activeConfig->getPivotId(pendingOperation.outputPivotIndex).c_str());
+                countOutput(context, pendingOperation.compiledOperationIndex, false);
+                continue;
+            }
+            int outputValue = measureOperation(pendingOperation.compiledOperationIndex);
+            OutputAttributes attributes = computeOutputAttributes(pendingOperation.compiledOperationIndex, outputValue, pendingOperation.sourceQuality);
+            if (!isOutputChanged(pendingOperation.outputPivotIndex, outputValue, attributes.quality)) {
+                SPOPERATORS_LOG_DEBUG("%s - FilterOperationSp::generatePendingOperations : Output %s unchanged, no reading generated", ConstantsOperation::NamePlugin.c_str(),
+                                      m_activeConfig->getPivotId(pendingOperation.outputPivotIndex).c_str());
+                countOutput(context, pendingOperation.compiledOperationIndex, false);
+                continue;
+            }
+            Reading* newReading = generateReadingOperation(pendingOperation.source, pendingOperation.compiledOperationIndex, outputValue, attributes);
+            SPOPERATORS_LOG_DEBUG("%s - FilterOperationSp::generatePendingOperations : Generation of the reading [%s]", ConstantsOperation::NamePlugin.c_str(), newReading->toJSON().c_str());
+            out_vectorReadingOperation.push_back(newReading);
+            countOutput(context, pendingOperation.compiledOperationIndex, true);
+            recordEmittedOutput(pendingOperation.outputPivotIndex, outputValue, attributes.quality);
+            if (propagateOutput(context, pendingOperation.compiledOperationIndex, outputValue, attributes, pendingOperation.sourceTimestamp)) {
+                uint64_t timestamp = attributes.replaceTimestamp ? attributes.timestamp : pendingOperation.sourceTimestamp;
+                for(const auto& operationLookup: m_activeConfig->getCompiledOperationsForInput(pendingOperation.outputPivotIndex)) {
+                    addPendingOperation(operationLookup, pendingOperation.source, timestamp, attributes.quality);
+                }
+            }
+        }
+    }
+    m_pendingOperations.clear();
+}
+
+/**
+ * Add the operations using an input to the chain buckets, each operation being added once
+ *
+ * @param context ingest context of the calling thread
+ * @param inputPivotIndex dense index of the input pivot ID
+ */
+void FilterOperationSp::scheduleOperations(IngestContext& context, int inputPivotIndex) {
+    for(const auto& operationLookup: m_activeConfig->getCompiledOperationsForInput(inputPivotIndex)) {
+        uint8_t& scheduled = m_scheduledOperations[operationLookup.compiledOperationIndex];
+        if (!scheduled) {
+            scheduled = 1;
+            context.chainBuckets[m_activeConfig->getChainLevel(operationLookup.compiledOperationIndex)].push_back(operationLookup);
+        }
+    }
+}
+
+/**
+ * Feed the value of a generated output to the operations using it, if the output is chained
+ * The output is stored as an input with the value, quality and timestamp of its reading
+ *
+ * @param context ingest context of the calling thread
+ * @param compiledOperationIndex index of the compiled operation that generated the output
+ * @param value value of the operation, as computed by evaluateOperation
+ * @param attributes quality and timestamp of the output, as computed by computeOutputAttributes
+ * @param triggerTimestamp timestamp of the input the output reading was built from
+ * @return true if the output is chained and the operations using it must be evaluated, else false
+ */
+bool FilterOperationSp::propagateOutput(IngestContext& context, int compiledOperationIndex, int value, const OutputAttributes& attributes, uint64_t triggerTimestamp) {
+    const CompiledOutput& compiledOutput = m_activeConfig->getCompiledOutput(m_activeConfig->getCompiledOperation(compiledOperationIndex).outputIndex);
+    if (!compiledOutput.chained) {
+        return false;
+    }
+    InputReading chainedInput;
+    chainedInput.pivotIndex = compiledOutput.pivotIndex;
+    // A SPS output only carries on or off
+    chainedInput.value = (compiledOutput.typeSps && value != PointState::StateOn) ? PointState::StateOff : value;
+    chainedInput.quality = attributes.quality;
+    chainedInput.timestamp = attributes.replaceTimestamp ? attributes.timestamp : triggerTimestamp;
+    updateCachedValue(context, chainedInput);
+    return true;
+}
+
+/**
+ * Check if an input reading is older than the last one received for the same input, when out of order readings are rejected
+ * Readings without timestamp are never rejected
+ *
+ * @param input input reading, as read by readInput
+ * @return true if the input reading must be ignored, else false
+ */
+bool FilterOperationSp::isOutOfOrder(const InputReading& input) const {
+    return m_ingestOptions.rejectOutOfOrder && input.timestamp != 0 && input.timestamp < m_inputStates.getTimestamp(input.pivotIndex);
+}
+
+/**
+ * Check if an input is the output of one of its own operations
+ *
+ * @param inputPivotIndex dense index of the input pivot ID
+ * @return true if the input is computed by one of the operations using it, else false
+ */
+bool FilterOperationSp::isOwnOutput(int inputPivotIndex) const {
+    for(const auto& operationLookup: m_activeConfig->getCompiledOperationsForInput(inputPivotIndex)) {
+        if (operationLookup.outputPivotIndex == inputPivotIndex) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Check if too few inputs of an operation were received, according to the known_inputs_ratio option
+ * Unknown inputs are counted incrementally, so the check costs nothing once every input is known
+ *
+ * @param compiledOperationIndex index of the compiled operation
+ * @return true if the fraction of known inputs is below the ratio, else false
+ */
+bool FilterOperationSp::hasTooManyUnknownInputs(int compiledOperationIndex) const {
+    uint32_t unknownCount = m_unknownCounts[compiledOperationIndex];
+    if (unknownCount == 0) {
+        return false;
+    }
+    const CompiledOperation& operation = m_activeConfig->getCompiledOperation(compiledOperationIndex);
+    double inputCount = static_cast<double>(operation.inputEnd - operation.inputBegin);
+    // The required number of known inputs is rounded up, the epsilon absorbs the rounding of the ratio
+    return inputCount - unknownCount < std::ceil(m_ingestOptions.knownInputsRatio * inputCount - 1e-9);
+}
+
+/**
+ * Store the new state, quality and timestamp of an input and update the counters of all operations using it
+ * Counters are only updated when the state, the quality or the timestamp actually changes, so that operations can be evaluated in O(1)
+ *
+ * @param context ingest context of the calling thread, collecting the inputs to save in the state file
+ * @param input input reading, as read by readInput
+ */
+void FilterOperationSp::updateCachedValue(IngestContext& context, const InputReading& input) {
+    int inputPivotIndex = input.pivotIndex;
+    int newValue = input.value;
+    uint16_t newQuality = input.quality;
+    int oldValue = m_inputStates.getValue(inputPivotIndex);
+    uint16_t oldQuality = m_inputStates.getQuality(inputPivotIndex);
+    uint64_t oldTimestamp = m_inputStates.getTimestamp(inputPivotIndex);
+    bool known = m_inputStates.isKnown(inputPivotIndex);
+    if (!known) {
+        m_inputStates.setKnown(inputPivotIndex);
+    }
+    // Single write of the state byte of the input, nothing else to do if neither the state, the quality nor the timestamp changed
+    bool valueChanged = m_inputStates.updateValue(inputPivotIndex, newValue);
+    if (known && !valueChanged && newQuality == oldQuality && input.timestamp == oldTimestamp) {
+        return;
+    }
+    m_inputStates.setQuality(inputPivotIndex, newQuality);
+    m_inputStates.setTimestamp(inputPivotIndex, input.timestamp);
+    if (m_stateWriter.isOpen()) {
+        context.changedInputs.push_back(inputPivotIndex);
+    }
+    bool countsChanged = valueChanged || newQuality != oldQuality;
+    // One lookup entry exists for each occurrence of the input in an operation, so the counters count occurrences.
+    // The input moves from one field of the packed counters to another, unsigned wrap-around makes the subtraction safe
+    uint64_t delta = StateCounts::unit(newValue) - StateCounts::unit(oldValue);
+    for(const auto& operationLookup: m_activeConfig->getCompiledOperationsForInput(inputPivotIndex)) {
+        if (!known) {
+            m_unknownCounts[operationLookup.compiledOperationIndex]--;
+        }
+        if (countsChanged) {
+            m_stateCounts[operationLookup.compiledOperationIndex] += delta;
+            if (m_qualityCountsEnabled) {
+                m_qualityCounts.remove(operationLookup.compiledOperationIndex, oldValue, oldQuality);
+                m_qualityCounts.add(operationLookup.compiledOperationIndex, newValue, newQuality);
+            }
+        }
+        if (m_timestampMaximaEnabled) {
+            m_timestampMaxima.move(operationLookup.compiledOperationIndex, oldValue, oldTimestamp, newValue, input.timestamp);
+        }
+    }
+}
+
+/**
+ * Check with the emit policy if a reading must be generated for an output
+ *
+ * @param outputPivotIndex dense index of the output pivot ID
+ * @param value computed value of the output
+ * @param quality quality of the output, only compared with the on-change-or-quality-change policy
+ * @return true if the output reading must be generated, else false
+ */
+bool FilterOperationSp::isOutputChanged(int outputPivotIndex, int value, uint16_t quality) const {
+    if (m_ingestOptions.emitPolicy == EmitPolicy::Always) {
+        return true;
+    }
+    const EmittedOutput& lastEmitted = m_lastEmitted[outputPivotIndex];
+    if (!lastEmitted.emitted || lastEmitted.value != value) {
+        return true;
+    }
+    return m_ingestOptions.emitPolicy == EmitPolicy::OnChangeOrQualityChange && lastEmitted.quality != quality;
+}
+
+/**
+ * Remember the last reading generated for an output, used by the emit policy
+ *
+ * @param outputPivotIndex dense index of the output pivot ID
+ * @param value value of the generated reading
+ * @param quality quality of the generated reading
+ */
+void FilterOperationSp::recordEmittedOutput(int outputPivotIndex, int value, uint16_t quality) {
+    EmittedOutput& lastEmitted = m_lastEmitted[outputPivotIndex];
+    lastEmitted.emitted = true;
+    lastEmitted.value = static_cast<int8_t>(value);
+    lastEmitted.quality = quality;
+}
+
+/**
+ * Compute the quality and the timestamp of an output according to the quality and timestamp policies
+ * With the trigger policies, the attributes of the input are copied as they are.
+ * When none of the inputs selected by the timestamp policy has a timestamp, the one of the input is copied as well.
+ * The contributing inputs are the ones whose state is the result for the threshold kernels, all the inputs for the others
+ *
+ * @param compiledOperationIndex index of the compiled operation
+ * @param value state of the operation, as computed by evaluateOperation
+ * @param triggerQuality quality of the input that triggered the operation
+ * @return the attributes of the output
+ */
+OutputAttributes FilterOperationSp::computeOutputAttributes(int compiledOperationIndex, int value, uint16_t triggerQuality) {
+    OutputAttributes attributes;
+    // Only the threshold kernels output the state of some of their inputs, the result of the others depends on all their inputs
+    bool contributingByState = (m_activeConfig->getCompiledOperation(compiledOperationIndex).kernel == OperationKernel::Threshold);
+    switch (m_ingestOptions.qualityPolicy) {
+        case QualityPolicy::WorstOf:
+            attributes.quality = m_qualityCounts.getWorstMask(compiledOperationIndex);
+            break;
+        case QualityPolicy::Contributing:
+            attributes.quality = contributingByState ? m_qualityCounts.getMask(compiledOperationIndex, value)
+                                                     : m_qualityCounts.getWorstMask(compiledOperationIndex);
+            break;
+        default:
+            attributes.quality = triggerQuality;
+            break;
+    }
+    attributes.replaceQuality = (m_ingestOptions.qualityPolicy != QualityPolicy::Trigger);
+    if (m_ingestOptions.unknownInputPolicy == UnknownInputPolicy::Questionable && hasTooManyUnknownInputs(compiledOperationIndex)) {
+        attributes.quality |= PivotQuality::ValidityQuestionable;
+        attributes.replaceQuality = true;
+    }
+
+    switch (m_ingestOptions.timestampPolicy) {
+        case TimestampPolicy::MaxOfInputs:
+            attributes.timestamp = getTimestampMaximum(compiledOperationIndex, TimestampMaxima::AllInputs);
+            break;
+        case TimestampPolicy::MaxOfContributingInputs:
+            attributes.timestamp = getTimestampMaximum(compiledOperationIndex, contributingByState ? value : TimestampMaxima::AllInputs);
+            break;
+        default:
+            break;
+    }
+    attributes.replaceTimestamp = (attributes.timestamp != 0);
+    return attributes;
+}
+
+/**
+ * Newest timestamp of a group of inputs of an operation
+ * The maximum is recomputed from the inputs only when the input that held it left the group or went back in time
+ *
+ * @param compiledOperationIndex index of the compiled operation
+ * @param group state of the inputs (PointState) or TimestampMaxima::AllInputs
+ * @return the newest packed timestamp of the inputs of the group, 0 if none has a timestamp
+ */
+uint64_t FilterOperationSp::getTimestampMaximum(int compiledOperationIndex, int group) {
+    if (m_timestampMaxima.isStale(compiledOperationIndex, group)) {
+        uint64_t maximum = 0;
+        const CompiledOperation& operation = m_activeConfig->getCompiledOperation(compiledOperationIndex);
+        for (int inputPivotIndex : m_activeConfig->getOperationInputs(operation)) {
+            if (group == TimestampMaxima::AllInputs || m_inputStates.getValue(inputPivotIndex) == group) {
+                maximum = std::max(maximum, m_inputStates.getTimestamp(inputPivotIndex));
+            }
+        }
+        m_timestampMaxima.setMaximum(compiledOperationIndex, group, maximum);
+    }
+    return m_timestampMaxima.getMaximum(compiledOperationIndex, group);
+}
+
+/**
+ * Compute the result of an operation from its state counters, with the kernel its type was compiled to
+ * If no value was received yet for an input, it is considered as off
+ *
+ * @param compiledOperationIndex index of the compiled operation to evaluate
+ * @return the state of the operation (PointState)
+ */
+int FilterOperationSp::evaluateOperation(int compiledOperationIndex) const {
+    const CompiledOperation& compiledOperation = m_activeConfig->getCompiledOperation(compiledOperationIndex);
+    uint64_t counts = m_stateCounts[compiledOperationIndex];
+    switch (compiledOperation.kernel) {
+        case OperationKernel::Parity:
+            return StateCounts::evaluateParity(counts, compiledOperation.kernelParameter);
+        case OperationKernel::Expression:
+            return OperationExpression::evaluate(m_activeConfig->getExpressionCode(compiledOperation),
+                                                 m_activeConfig->getOperationInputs(compiledOperation).begin(), m_inputStates);
+        default:
+            return StateCounts::evaluateThreshold(counts, compiledOperation.kernelParameter);
+    }
+}
+
+/**
+ * Evaluate an operation, counting the evaluation when the operation_stats option is enabled
+ * Its duration is measured with the rest of the work for the output by the OperationTimer of the caller
+ *
+ * @param compiledOperationIndex index of the compiled operation to evaluate
+ * @return the state of the operation (PointState)
+ */
+int FilterOperationSp::measureOperation(int compiledOperationIndex) {
+    if (m_ingestOptions.operationStats) {
+        m_operationStats.recordEvaluation(compiledOperationIndex);
+    }
+    return evaluateOperation(compiledOperationIndex);
+}
+
+/**
+ * Store the value of an input reading with updateCachedValue. When the operation_stats option is enabled,
+ * the duration of the update is shared between the operations of the input, so that an operation with many
+ * inputs is charged with the updates of its counters
+ *
+ * @param context ingest context of the calling thread
+ * @param input input reading, as read by readInput
+ */
+void FilterOperationSp::updateMeasuredValue(IngestContext& context, const InputReading& input) {
+    if (!m_ingestOptions.operationStats) {
+        updateCachedValue(context, input);
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    updateCachedValue(context, input);
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    ConstSpan<CompiledLookup> operationsLookup = m_activeConfig->getCompiledOperationsForInput(input.pivotIndex);
+    if (operationsLookup.empty()) {
+        return;
+    }
+    uint64_t share = static_cast<uint64_t>(duration.count()) / operationsLookup.size();
+    for (const auto& operationLookup: operationsLookup) {
+        m_operationStats.recordTime(operationLookup.compiledOperationIndex, share);
+    }
+}
+
+/**
+ * Count an output generated or suppressed in the metrics and, when the operation_stats option is enabled, in the statistics of its operation
+ *
+ * @param context ingest context of the calling thread
+ * @param compiledOperationIndex index of the compiled operation of the output
+ * @param emitted true if an output reading was generated, false if it was suppressed
+ */
+void FilterOperationSp::countOutput(IngestContext& context, int compiledOperationIndex, bool emitted) {
+    context.metricCounts.add(emitted ? MetricCounter::OutputsGenerated : MetricCounter::OutputsSuppressed);
+    if (m_ingestOptions.operationStats) {
+        m_operationStats.recordOutput(compiledOperationIndex, emitted);
+    }
+}
+
 /**
  * Generate of reading for operation
  * 
  * @param reading initial reading
  * @param outputPivotId pivot ID of the output TI to produce
+ * @param operationIndex index of the operation of the output TI to apply
  * @return a modified reading
 */
 Reading *FilterOperationSp::generateReadingOperation(const Reading *reading, const std::string& outputPivotId, int operationIndex) {
-    string beforeLog = ConstantsOperation::NamePlugin + " - FilterOperationSp::generateReadingOperation :";
-    
+    lock_guard<mutex> ingestGuard(m_ingestMutex);
+    std::shared_ptr<const ConfigOperation> publishedConfig;
+    {
+        lock_guard<mutex> guard(m_configMutex);
+        m_ingestOptions = m_options;
+        publishedConfig = m_publishedConfig;
+    }
+    refreshActiveConfig(publishedConfig);
+
     // Find operation info to generate the reading
-    const auto& dataOperations = m_configOperation.getDataOperations();
-    if (dataOperations.count(outputPivotId) == 0) {
-        UtilityOperation::log_debug("%s No data operation found for output Pivot ID '%s', reading creation cancelled",
-                                    beforeLog.c_str(), outputPivotId.c_str());
+    int compiledOperationIndex = m_activeConfig->findCompiledOperation(outputPivotId, operationIndex);
+    if (compiledOperationIndex < 0) {
+        SPOPERATORS_LOG_DEBUG("%s - FilterOperationSp::generateReadingOperation : No data operation found for output Pivot ID '%s', reading creation cancelled",
+                              ConstantsOperation::NamePlugin.c_str(), outputPivotId.c_str());
         return nullptr;
     }
-    const auto& operationsInfo = dataOperations.at(outputPivotId);
-    const auto& operationInfo = operationsInfo.operations.at(operationIndex);
 
-    // Compute new reading value by applying operation logic
-    const std::string& operationType = operationInfo.operationType;
-    int newValue = 0;
-    for(const std::string& inputPivotId: operationInfo.inputPivotIds) {
-        if (operationType == "or") {
-            // If no cached value was registered for this Pivot ID, it will automatically initialize it at 0
-            newValue = newValue || m_cachedValues[inputPivotId]; 
-        }
-    }
-    bool targetTypeSps = (operationsInfo.outputPivotType == ConstantsOperation::JsonCdcSps);
-    
     // Ensure input reading is not null
     if (reading == nullptr) {
-        UtilityOperation::log_debug("%s Input reading is null, %s reading creation cancelled", beforeLog.c_str(), outputPivotId.c_str());
+        SPOPERATORS_LOG_DEBUG("%s - FilterOperationSp::generateReadingOperation : Input reading is null, %s reading creation cancelled", ConstantsOperation::NamePlugin.c_str(), outputPivotId.c_str());
         return nullptr;
     }
-    beforeLog = ConstantsOperation::NamePlugin + " - " + reading->getAssetName() + " - FilterOperationSp::generateReadingOperation :";
+    const string& assetName = reading->getAssetName();
 
-    // Deep copy on Datapoint
+    PivotReadingView input;
     Datapoint *dpRoot = reading->getDatapoint(ConstantsOperation::KeyMessagePivotJsonRoot);
     if (dpRoot == nullptr) {
-        UtilityOperation::log_debug("%s Attribute %s missing, %s reading creation cancelled", beforeLog.c_str(),
-                                    ConstantsOperation::KeyMessagePivotJsonRoot.c_str(), outputPivotId.c_str());
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::generateReadingOperation : Attribute %s missing, %s reading creation cancelled", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(),
+                              ConstantsOperation::KeyMessagePivotJsonRoot.c_str(), outputPivotId.c_str());
         return nullptr;
     }
+    input.pivot = dpRoot->getData().getDpVec();
 
-    DatapointValue newValueOperation(dpRoot->getData());
-
-    // Generate ouput reading
-    Datapoints *dpGtis = findDictElement(newValueOperation.getDpVec(), ConstantsOperation::KeyMessagePivotJsonGt);
-    if (dpGtis == nullptr) {
-        UtilityOperation::log_debug("%s Attribute %s missing, %s reading creation cancelled", beforeLog.c_str(),
-                                    ConstantsOperation::KeyMessagePivotJsonGt.c_str(), outputPivotId.c_str());
+    input.gtis = findDictElement(input.pivot, ConstantsOperation::KeyMessagePivotJsonGt);
+    if (input.gtis == nullptr) {
+        SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::generateReadingOperation : Attribute %s missing, %s reading creation cancelled", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(),
+                              ConstantsOperation::KeyMessagePivotJsonGt.c_str(), outputPivotId.c_str());
         return nullptr;
     }
-    
-    // Overwrite identifier
-    createStringElement(dpGtis, ConstantsOperation::KeyMessagePivotJsonId, outputPivotId);
 
-    bool typeSps = true;
-    Datapoints *dpTyp = findDictElement(dpGtis, ConstantsOperation::JsonCdcSps);
-    if (dpTyp == nullptr) {
-        dpTyp = findDictElement(dpGtis, ConstantsOperation::JsonCdcDps);
-        
-        if (dpTyp == nullptr) {
-            UtilityOperation::log_debug("%s Attribute CDC missing, %s reading creation cancelled", beforeLog.c_str(), outputPivotId.c_str());
+    input.cdc = findDictElement(input.gtis, ConstantsOperation::JsonCdcSps);
+    if (input.cdc == nullptr) {
+        input.cdc = findDictElement(input.gtis, ConstantsOperation::JsonCdcDps);
+        if (input.cdc == nullptr) {
+            SPOPERATORS_LOG_DEBUG("%s - %s - FilterOperationSp::generateReadingOperation : Attribute CDC missing, %s reading creation cancelled", ConstantsOperation::NamePlugin.c_str(), assetName.c_str(), outputPivotId.c_str());
             return nullptr;
         }
-        typeSps = false;
-    }
-    // If the output type does not match the current type found in the reading, rewrite that part of the reading
-    if (typeSps != targetTypeSps) {
-        Datapoint *cdcTypeDp = findDatapointElement(dpGtis, typeSps?ConstantsOperation::JsonCdcSps:ConstantsOperation::JsonCdcDps);
-        cdcTypeDp->setName(operationsInfo.outputPivotType);
-    }
-    // Set computed value
-    if (targetTypeSps) {
-        createIntegerElement(dpTyp, ConstantsOperation::KeyMessagePivotJsonStVal, newValue);
-    }
-    else {
-        createStringElement(dpTyp, ConstantsOperation::KeyMessagePivotJsonStVal, newValue?"on":"off");
-    }
-    // Update quality
-    Datapoints *dpQ = findDictElement(dpTyp, ConstantsOperation::KeyMessagePivotJsonQ);
-    if (dpQ == nullptr) {
-        Datapoint *datapointQ = createDictElement(dpTyp, ConstantsOperation::KeyMessagePivotJsonQ);
-        dpQ = datapointQ->getData().getDpVec();
     }
 
-    createStringElement(dpQ, ConstantsOperation::KeyMessagePivotJsonSource, ConstantsOperation::ValueSubstituted);
+    int value = evaluateOperation(compiledOperationIndex);
+    uint16_t triggerQuality = PivotQuality::encode(findDictElement(input.cdc, ConstantsOperation::KeyMessagePivotJsonQ));
+    return generateReadingOperation(input, compiledOperationIndex, value, computeOutputAttributes(compiledOperationIndex, value, triggerQuality));
+}
 
-    auto newDatapointOperation = new Datapoint(dpRoot->getName(), newValueOperation);
-    auto newReading = new Reading(operationsInfo.outputAssetName, newDatapointOperation);
-    return newReading;
+/**
+ * Generate of reading for a compiled operation
+ * The output reading is built from the prebuilt template of the output, only the attributes
+ * that are not fixed by the template are copied from the input.
+ * With the trigger policies the quality and timestamp of the input are copied as well, else they are replaced by the computed ones
+ * 
+ * @param input elements of the initial reading
+ * @param compiledOperationIndex index of the compiled operation to apply
+ * @param value value of the operation, as computed by evaluateOperation
+ * @param attributes quality and timestamp of the output, as computed by computeOutputAttributes
+ * @return a new reading
+*/
+Reading *FilterOperationSp::generateReadingOperation(const PivotReadingView& input, int compiledOperationIndex, int value, const OutputAttributes& attributes) {
+    const CompiledOperation& compiledOperation = m_activeConfig->getCompiledOperation(compiledOperationIndex);
+    const CompiledOutput& compiledOutput = m_activeConfig->getCompiledOutput(compiledOperation.outputIndex);
+
+    Datapoint *newDatapointOperation = compiledOutput.readingTemplate->instantiate(value, input, attributes);
+    return new Reading(compiledOutput.assetName, newDatapointOperation);
 }
 
 /**
  * Reconfiguration entry point to the filter.
  *
- * This method runs holding the configMutex to prevent
- * ingest using the regex class that may be destroyed by this
- * call.
- *
- * Pass the configuration to the base FilterPlugin class and
- * then call the private method to handle the filter specific
- * configuration.
+ * The exchanged_data are compiled into a new configuration snapshot
+ * without holding any lock, so that ingest is never blocked by the parsing.
+ * Only the update of the base FilterPlugin class configuration and of the
+ * filter options runs holding the configMutex.
  *
  * @param newConfig  The JSON of the new configuration
  */
 void FilterOperationSp::reconfigure(const std::string& newConfig) {
-    lock_guard<mutex> guard(m_configMutex);
-    setConfig(newConfig);
-
     ConfigCategory config("newConfig", newConfig);
+    std::shared_ptr<const ConfigOperation> compiledConfig;
     if (config.itemExists("exchanged_data")) {
-        this->setJsonConfig(config.getValue("exchanged_data"));
+        compiledConfig = compileJsonConfig(config.getValue("exchanged_data"));
+    }
+
+    // A reading set sees either the previous configuration and options or both new ones
+    lock_guard<mutex> guard(m_configMutex);
+    setConfig(newConfig);
+    m_options.importConfig(config);
+    if (compiledConfig) {
+        std::atomic_store(&m_publishedConfig, compiledConfig);
     }
 }
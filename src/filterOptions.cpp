@@ -0,0 +1,160 @@
+/*
+ * Options of the filter read from the plugin configuration (other than exchanged_data)
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "constantsOperation.h"
+#include "filterOptions.h"
+#include "utilityOperation.h"
+
+#include <cstdlib>
+
+using namespace std;
+
+/**
+ * Read the options found in a configuration category
+ * Options missing from the category keep their current value, invalid values are reported and replaced by the default
+ *
+ * @param config : Configuration category of the plugin
+ */
+void FilterOptions::importConfig(const ConfigCategory& config) {
+    if (config.itemExists(ConstantsOperation::JsonEmitPolicy)) {
+        string emitPolicyValue = config.getValue(ConstantsOperation::JsonEmitPolicy);
+        if (emitPolicyValue == ConstantsOperation::ValueEmitAlways) {
+            emitPolicy = EmitPolicy::Always;
+        }
+        else if (emitPolicyValue == ConstantsOperation::ValueEmitOnChange) {
+            emitPolicy = EmitPolicy::OnChange;
+        }
+        else if (emitPolicyValue == ConstantsOperation::ValueEmitOnChangeOrQualityChange) {
+            emitPolicy = EmitPolicy::OnChangeOrQualityChange;
+        }
+        else {
+            UtilityOperation::log_error("%s - FilterOptions::importConfig : Invalid %s '%s', '%s' is used", ConstantsOperation::NamePlugin.c_str(),
+                                        ConstantsOperation::JsonEmitPolicy, emitPolicyValue.c_str(), ConstantsOperation::ValueEmitAlways);
+            emitPolicy = EmitPolicy::Always;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonCoalesceOutputs)) {
+        coalesceOutputs = (config.getValue(ConstantsOperation::JsonCoalesceOutputs) == "true");
+    }
+    if (config.itemExists(ConstantsOperation::JsonQualityPolicy)) {
+        string qualityPolicyValue = config.getValue(ConstantsOperation::JsonQualityPolicy);
+        if (qualityPolicyValue == ConstantsOperation::ValueQualityTrigger) {
+            qualityPolicy = QualityPolicy::Trigger;
+        }
+        else if (qualityPolicyValue == ConstantsOperation::ValueQualityWorstOf) {
+            qualityPolicy = QualityPolicy::WorstOf;
+        }
+        else if (qualityPolicyValue == ConstantsOperation::ValueQualityContributing) {
+            qualityPolicy = QualityPolicy::Contributing;
+        }
+        else {
+            UtilityOperation::log_error("%s - FilterOptions::importConfig : Invalid %s '%s', '%s' is used", ConstantsOperation::NamePlugin.c_str(),
+                                        ConstantsOperation::JsonQualityPolicy, qualityPolicyValue.c_str(), ConstantsOperation::ValueQualityTrigger);
+            qualityPolicy = QualityPolicy::Trigger;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonTimestampPolicy)) {
+        string timestampPolicyValue = config.getValue(ConstantsOperation::JsonTimestampPolicy);
+        if (timestampPolicyValue == ConstantsOperation::ValueTimestampTrigger) {
+            timestampPolicy = TimestampPolicy::Trigger;
+        }
+        else if (timestampPolicyValue == ConstantsOperation::ValueTimestampMaxOfInputs) {
+            timestampPolicy = TimestampPolicy::MaxOfInputs;
+        }
+        else if (timestampPolicyValue == ConstantsOperation::ValueTimestampMaxOfContributing) {
+            timestampPolicy = TimestampPolicy::MaxOfContributingInputs;
+        }
+        else {
+            UtilityOperation::log_error("%s - FilterOptions::importConfig : Invalid %s '%s', '%s' is used", ConstantsOperation::NamePlugin.c_str(),
+                                        ConstantsOperation::JsonTimestampPolicy, timestampPolicyValue.c_str(), ConstantsOperation::ValueTimestampTrigger);
+            timestampPolicy = TimestampPolicy::Trigger;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonRejectOutOfOrder)) {
+        rejectOutOfOrder = (config.getValue(ConstantsOperation::JsonRejectOutOfOrder) == "true");
+    }
+    if (config.itemExists(ConstantsOperation::JsonStateFile)) {
+        stateFile = config.getValue(ConstantsOperation::JsonStateFile);
+    }
+    if (config.itemExists(ConstantsOperation::JsonStateMaxAge)) {
+        string stateMaxAgeValue = config.getValue(ConstantsOperation::JsonStateMaxAge);
+        char *end = nullptr;
+        stateMaxAge = strtol(stateMaxAgeValue.c_str(), &end, 10);
+        if (stateMaxAgeValue.empty() || *end != '\0' || stateMaxAge < 0) {
+            UtilityOperation::log_error("%s - FilterOptions::importConfig : Invalid %s '%s', 0 is used", ConstantsOperation::NamePlugin.c_str(),
+                                        ConstantsOperation::JsonStateMaxAge, stateMaxAgeValue.c_str());
+            stateMaxAge = 0;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonStateFlushInterval)) {
+        string stateFlushIntervalValue = config.getValue(ConstantsOperation::JsonStateFlushInterval);
+        char *end = nullptr;
+        stateFlushInterval = strtol(stateFlushIntervalValue.c_str(), &end, 10);
+        if (stateFlushIntervalValue.empty() || *end != '\0' || stateFlushInterval < 0) {
+            UtilityOperation::log_error("%s - FilterOptions::importConfig : Invalid %s '%s', 1000 is used", ConstantsOperation::NamePlugin.c_str(),
+                                        ConstantsOperation::JsonStateFlushInterval, stateFlushIntervalValue.c_str());
+            stateFlushInterval = 1000;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonUnknownInputPolicy)) {
+        string unknownInputPolicyValue = config.getValue(ConstantsOperation::JsonUnknownInputPolicy);
+        if (unknownInputPolicyValue == ConstantsOperation::ValueUnknownAssumeOff) {
+            unknownInputPolicy = UnknownInputPolicy::AssumeOff;
+        }
+        else if (unknownInputPolicyValue == ConstantsOperation::ValueUnknownWithhold) {
+            unknownInputPolicy = UnknownInputPolicy::Withhold;
+        }
+        else if (unknownInputPolicyValue == ConstantsOperation::ValueUnknownQuestionable) {
+            unknownInputPolicy = UnknownInputPolicy::Questionable;
+        }
+        else {
+            UtilityOperation::log_error("%s - FilterOptions::importConfig : Invalid %s '%s', '%s' is used", ConstantsOperation::NamePlugin.c_str(),
+                                        ConstantsOperation::JsonUnknownInputPolicy, unknownInputPolicyValue.c_str(), ConstantsOperation::ValueUnknownAssumeOff);
+            unknownInputPolicy = UnknownInputPolicy::AssumeOff;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonKnownInputsRatio)) {
+        string knownInputsRatioValue = config.getValue(ConstantsOperation::JsonKnownInputsRatio);
+        char *end = nullptr;
+        knownInputsRatio = strtod(knownInputsRatioValue.c_str(), &end);
+        if (knownInputsRatioValue.empty() || *end != '\0' || !(knownInputsRatio > 0.0 && knownInputsRatio <= 1.0)) {
+            UtilityOperation::log_error("%s - FilterOptions::importConfig : Invalid %s '%s', 1 is used", ConstantsOperation::NamePlugin.c_str(),
+                                        ConstantsOperation::JsonKnownInputsRatio, knownInputsRatioValue.c_str());
+            knownInputsRatio = 1.0;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonWorkerThreads)) {
+        string workerThreadsValue = config.getValue(ConstantsOperation::JsonWorkerThreads);
+        char *end = nullptr;
+        workerThreads = strtol(workerThreadsValue.c_str(), &end, 10);
+        if (workerThreadsValue.empty() || *end != '\0' || workerThreads < 0 || workerThreads > MaxWorkerThreads) {
+            UtilityOperation::log_error("%s - FilterOptions::importConfig : Invalid %s '%s', 0 is used", ConstantsOperation::NamePlugin.c_str(),
+                                        ConstantsOperation::JsonWorkerThreads, workerThreadsValue.c_str());
+            workerThreads = 0;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonMetricsInterval)) {
+        string metricsIntervalValue = config.getValue(ConstantsOperation::JsonMetricsInterval);
+        char *end = nullptr;
+        metricsInterval = strtol(metricsIntervalValue.c_str(), &end, 10);
+        if (metricsIntervalValue.empty() || *end != '\0' || metricsInterval < 0) {
+            UtilityOperation::log_error("%s - FilterOptions::importConfig : Invalid %s '%s', 0 is used", ConstantsOperation::NamePlugin.c_str(),
+                                        ConstantsOperation::JsonMetricsInterval, metricsIntervalValue.c_str());
+            metricsInterval = 0;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonMetricsAsset)) {
+        metricsAsset = config.getValue(ConstantsOperation::JsonMetricsAsset);
+        if (metricsAsset.empty()) {
+            metricsAsset = ConstantsOperation::ValueMetricsAsset;
+        }
+    }
+    if (config.itemExists(ConstantsOperation::JsonOperationStats)) {
+        operationStats = (config.getValue(ConstantsOperation::JsonOperationStats) == "true");
+    }
+}
@@ -0,0 +1,190 @@
+/*
+ * Counters and latency histograms of the work done by the filter
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "ingestMetrics.h"
+
+#include <datapoint.h>
+#include <datapoint_utility.h>
+
+#include <cmath>
+
+using namespace std;
+using namespace DatapointUtility;
+
+namespace {
+    // Names of the counters in the metrics reading, in the order of MetricCounter
+    const char* const CounterNames[] = {
+        "readings_in",
+        "readings_matched",
+        "ignored_missing_pivot",
+        "ignored_missing_gtis",
+        "ignored_missing_identifier",
+        "ignored_no_operation",
+        "ignored_missing_cdc",
+        "ignored_missing_stval",
+        "ignored_out_of_order",
+        "outputs_generated",
+        "outputs_suppressed",
+        "inputs_deleted",
+    };
+    static_assert(sizeof(CounterNames) / sizeof(CounterNames[0]) == static_cast<size_t>(MetricCounter::Count), "Missing counter name");
+
+    int highestBit(uint64_t value) {
+        return 63 - __builtin_clzll(value);
+    }
+};
+
+const int LatencyHistogram::SubBucketBits;
+const size_t LatencyHistogram::SubBucketCount;
+const size_t LatencyHistogram::BucketCount;
+
+LatencyHistogram::LatencyHistogram():
+    m_count(0),
+    m_sum(0),
+    m_max(0)
+{
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, memory_order_relaxed);
+    }
+}
+
+/**
+ * Index of the bucket of a value: values below SubBucketCount have their own bucket,
+ * larger ones are located by their highest bit and the SubBucketBits bits following it
+ *
+ * @param value : Recorded value
+ * @return The index of the bucket
+ */
+size_t LatencyHistogram::getBucketIndex(uint64_t value) {
+    if (value < SubBucketCount) {
+        return static_cast<size_t>(value);
+    }
+    int exponent = highestBit(value);
+    int shift = exponent - SubBucketBits;
+    return SubBucketCount * (shift + 1) + static_cast<size_t>((value >> shift) - SubBucketCount);
+}
+
+/**
+ * Largest value stored in a bucket
+ *
+ * @param bucketIndex : Index of the bucket
+ * @return The largest value of the bucket
+ */
+uint64_t LatencyHistogram::getBucketUpperBound(size_t bucketIndex) {
+    if (bucketIndex < SubBucketCount) {
+        return bucketIndex;
+    }
+    int shift = static_cast<int>(bucketIndex / SubBucketCount) - 1;
+    uint64_t lowerBound = static_cast<uint64_t>(SubBucketCount + bucketIndex % SubBucketCount) << shift;
+    return lowerBound + ((static_cast<uint64_t>(1) << shift) - 1);
+}
+
+/**
+ * Record a value
+ *
+ * @param value : Duration in nanoseconds
+ */
+void LatencyHistogram::record(uint64_t value) {
+    m_buckets[getBucketIndex(value)].fetch_add(1, memory_order_relaxed);
+    m_count.fetch_add(1, memory_order_relaxed);
+    m_sum.fetch_add(value, memory_order_relaxed);
+    uint64_t max = m_max.load(memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @return The mean of the recorded values, 0 if none was recorded
+ */
+uint64_t LatencyHistogram::getMean() const {
+    uint64_t count = getCount();
+    return count == 0 ? 0 : m_sum.load(memory_order_relaxed) / count;
+}
+
+/**
+ * Value below which a percentage of the recorded values fall, within the precision of the buckets
+ *
+ * @param percentile : Percentage between 0 and 100
+ * @return The upper bound of the bucket holding the value, never more than the largest value recorded, 0 if none was recorded
+ */
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const {
+    uint64_t count = getCount();
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(ceil(percentile / 100.0 * static_cast<double>(count)));
+    rank = max<uint64_t>(rank, 1);
+    uint64_t cumulated = 0;
+    for (size_t bucketIndex = 0 ; bucketIndex < BucketCount ; bucketIndex++) {
+        cumulated += m_buckets[bucketIndex].load(memory_order_relaxed);
+        if (cumulated >= rank) {
+            return min(getBucketUpperBound(bucketIndex), getMax());
+        }
+    }
+    return getMax();
+}
+
+/**
+ * Summary of the histogram: count, mean, percentiles and maximum
+ *
+ * @param name : Name of the datapoint
+ * @return A new dictionary datapoint
+ */
+Datapoint* LatencyHistogram::toDatapoint(const string& name) const {
+    Datapoints *children = new Datapoints;
+    DatapointValue value(children, true);
+    Datapoint *datapoint = new Datapoint(name, value);
+    Datapoints *histogram = datapoint->getData().getDpVec();
+    createIntegerElement(histogram, "count", static_cast<long>(getCount()));
+    createIntegerElement(histogram, "mean_ns", static_cast<long>(getMean()));
+    createIntegerElement(histogram, "p50_ns", static_cast<long>(getValueAtPercentile(50.0)));
+    createIntegerElement(histogram, "p90_ns", static_cast<long>(getValueAtPercentile(90.0)));
+    createIntegerElement(histogram, "p99_ns", static_cast<long>(getValueAtPercentile(99.0)));
+    createIntegerElement(histogram, "p999_ns", static_cast<long>(getValueAtPercentile(99.9)));
+    createIntegerElement(histogram, "max_ns", static_cast<long>(getMax()));
+    return datapoint;
+}
+
+IngestMetrics::IngestMetrics() {
+    for (auto& counter : m_counters) {
+        counter.store(0, memory_order_relaxed);
+    }
+}
+
+/**
+ * Add the counters of a thread and reset them
+ *
+ * @param counts : Counters local to a thread
+ */
+void IngestMetrics::add(MetricCounts& counts) {
+    for (int i = 0 ; i < static_cast<int>(MetricCounter::Count) ; i++) {
+        if (counts.counts[i] != 0) {
+            m_counters[i].fetch_add(counts.counts[i], memory_order_relaxed);
+            counts.counts[i] = 0;
+        }
+    }
+}
+
+/**
+ * All the counters and histograms, as sent in the metrics reading
+ *
+ * @param name : Name of the datapoint
+ * @return A new dictionary datapoint
+ */
+Datapoint* IngestMetrics::toDatapoint(const string& name) const {
+    Datapoints *children = new Datapoints;
+    DatapointValue value(children, true);
+    Datapoint *datapoint = new Datapoint(name, value);
+    Datapoints *metrics = datapoint->getData().getDpVec();
+    for (int i = 0 ; i < static_cast<int>(MetricCounter::Count) ; i++) {
+        createIntegerElement(metrics, CounterNames[i], static_cast<long>(get(static_cast<MetricCounter>(i))));
+    }
+    metrics->push_back(ingestLatency.toDatapoint("ingest_latency"));
+    metrics->push_back(configLatency.toDatapoint("config_latency"));
+    return datapoint;
+}
@@ -0,0 +1,339 @@
+/*
+ * Expressions of operations, compiled to a postfix bytecode
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "operationExpression.h"
+#include "pointState.h"
+
+#include <cctype>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+    // Results of the operators for each pair of states, indexed by PointState
+    const int8_t notTable[PointState::StateCount] = {PointState::StateOn, PointState::StateOff, PointState::StateIntermediate, PointState::StateBad};
+    const int8_t andTable[PointState::StateCount][PointState::StateCount] = {{0, 0, 0, 0}, {0, 1, 2, 3}, {0, 2, 2, 2}, {0, 3, 2, 3}};
+    const int8_t orTable[PointState::StateCount][PointState::StateCount] = {{0, 1, 2, 3}, {1, 1, 1, 1}, {2, 1, 2, 3}, {3, 1, 3, 3}};
+    const int8_t xorTable[PointState::StateCount][PointState::StateCount] = {{0, 1, 2, 3}, {1, 0, 2, 3}, {2, 2, 2, 3}, {3, 3, 3, 3}};
+
+    /**
+     * Recursive descent parser of an expression, emitting the postfix bytecode while parsing
+     */
+    class Parser {
+    public:
+        Parser(const string& text, vector<string>& out_inputPivotIds, vector<ExpressionInstruction>& out_code):
+            m_text(text), m_inputPivotIds(out_inputPivotIds), m_code(out_code) {}
+
+        bool parse(string& out_error) {
+            if (!parseOr() || !expectEnd()) {
+                out_error = m_error;
+                return false;
+            }
+            emit(ExpressionInstruction::Return, 0, 0);
+            return true;
+        }
+
+    private:
+        bool parseOr() {
+            // Every nested parenthesis or count argument goes through here, the parse is abandoned on the first failure
+            if (++m_nesting > OperationExpression::MaxNestingDepth) {
+                return fail("expression too deep");
+            }
+            if (!parseXor()) {
+                return false;
+            }
+            while (acceptKeyword("or")) {
+                if (!parseXor()) {
+                    return false;
+                }
+                emit(ExpressionInstruction::Or, 2, 0);
+            }
+            m_nesting--;
+            return true;
+        }
+
+        bool parseXor() {
+            if (!parseAnd()) {
+                return false;
+            }
+            while (acceptKeyword("xor")) {
+                if (!parseAnd()) {
+                    return false;
+                }
+                emit(ExpressionInstruction::Xor, 2, 0);
+            }
+            return true;
+        }
+
+        bool parseAnd() {
+            if (!parseNot()) {
+                return false;
+            }
+            while (acceptKeyword("and")) {
+                if (!parseNot()) {
+                    return false;
+                }
+                emit(ExpressionInstruction::And, 2, 0);
+            }
+            return true;
+        }
+
+        bool parseNot() {
+            // A sequence of "not" is read iteratively, it does not nest
+            int notCount = 0;
+            while (acceptKeyword("not")) {
+                notCount++;
+            }
+            if (!parsePrimary()) {
+                return false;
+            }
+            for (int i = 0 ; i < notCount ; i++) {
+                emit(ExpressionInstruction::Not, 1, 0);
+            }
+            return true;
+        }
+
+        bool parsePrimary() {
+            if (accept("(")) {
+                return parseOr() && expect(")");
+            }
+            if (acceptKeyword("count")) {
+                return parseCount();
+            }
+            string pivotId = readWord();
+            if (pivotId.empty()) {
+                return fail("pivot ID expected");
+            }
+            if (pivotId == "and" || pivotId == "or" || pivotId == "xor" || pivotId == "not") {
+                return fail("pivot ID expected before '" + pivotId + "'");
+            }
+            uint32_t inputIndex = 0;
+            while (inputIndex < m_inputPivotIds.size() && m_inputPivotIds[inputIndex] != pivotId) {
+                inputIndex++;
+            }
+            if (inputIndex == m_inputPivotIds.size()) {
+                m_inputPivotIds.push_back(pivotId);
+            }
+            emit(ExpressionInstruction::Input, 0, inputIndex);
+            return true;
+        }
+
+        bool parseCount() {
+            if (!expect("(")) {
+                return false;
+            }
+            uint16_t argumentCount = 0;
+            // The arguments in each state are counted in the fields of StateCounts
+            static_assert(UINT16_MAX <= StateCounts::FieldMask, "count arguments overflow the fields of StateCounts");
+            do {
+                if (argumentCount == UINT16_MAX) {
+                    return fail("too many count arguments");
+                }
+                if (!parseOr()) {
+                    return false;
+                }
+                argumentCount++;
+            } while (accept(","));
+            if (!expect(")")) {
+                return false;
+            }
+
+            // Every comparison is expressed with the threshold of "count_ge"
+            ExpressionInstruction::Comparison comparison = ExpressionInstruction::GreaterOrEqual;
+            long offset = 0;
+            if (accept(">=")) {
+            }
+            else if (accept("<=")) {
+                comparison = ExpressionInstruction::Less;
+                offset = 1;
+            }
+            else if (accept("==")) {
+                comparison = ExpressionInstruction::Equal;
+            }
+            else if (accept("!=")) {
+                comparison = ExpressionInstruction::NotEqual;
+            }
+            else if (accept(">")) {
+                offset = 1;
+            }
+            else if (accept("<")) {
+                comparison = ExpressionInstruction::Less;
+            }
+            else {
+                return fail("comparison expected after count");
+            }
+            string number = readWord();
+            char *numberEnd = nullptr;
+            long threshold = number.empty() ? -1 : strtol(number.c_str(), &numberEnd, 10);
+            if (threshold < 0 || *numberEnd != '\0' || threshold + offset > UINT16_MAX) {
+                return fail("positive integer expected after count comparison");
+            }
+            emit(ExpressionInstruction::Count, argumentCount, static_cast<uint32_t>(threshold + offset), comparison);
+            return true;
+        }
+
+        void emit(ExpressionInstruction::Opcode opcode, uint16_t popCount, uint32_t operand,
+                  ExpressionInstruction::Comparison comparison = ExpressionInstruction::GreaterOrEqual) {
+            ExpressionInstruction instruction;
+            instruction.opcode = opcode;
+            instruction.comparison = comparison;
+            instruction.argumentCount = popCount;
+            instruction.operand = operand;
+            m_code.push_back(instruction);
+            if (opcode == ExpressionInstruction::Return) {
+                return;
+            }
+            // Every instruction pushes one state
+            m_depth = m_depth - popCount + 1;
+            if (m_depth > OperationExpression::MaxStackDepth) {
+                m_tooDeep = true;
+            }
+        }
+
+        void skipSpaces() {
+            while (m_position < m_text.size() && isspace(static_cast<unsigned char>(m_text[m_position]))) {
+                m_position++;
+            }
+        }
+
+        static bool isWordCharacter(char c) {
+            return isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' || c == '-';
+        }
+
+        string readWord() {
+            skipSpaces();
+            size_t begin = m_position;
+            while (m_position < m_text.size() && isWordCharacter(m_text[m_position])) {
+                m_position++;
+            }
+            return m_text.substr(begin, m_position - begin);
+        }
+
+        bool accept(const char *token) {
+            skipSpaces();
+            size_t length = char_traits<char>::length(token);
+            if (m_text.compare(m_position, length, token) != 0) {
+                return false;
+            }
+            m_position += length;
+            return true;
+        }
+
+        bool acceptKeyword(const char *keyword) {
+            skipSpaces();
+            size_t length = char_traits<char>::length(keyword);
+            if (m_text.compare(m_position, length, keyword) != 0
+                || (m_position + length < m_text.size() && isWordCharacter(m_text[m_position + length]))) {
+                return false;
+            }
+            m_position += length;
+            return true;
+        }
+
+        bool expect(const char *token) {
+            return accept(token) || fail(string("'") + token + "' expected");
+        }
+
+        bool expectEnd() {
+            skipSpaces();
+            if (m_position != m_text.size()) {
+                return fail("unexpected characters");
+            }
+            if (m_tooDeep) {
+                m_error = "expression too deep";
+                return false;
+            }
+            return true;
+        }
+
+        bool fail(const string& message) {
+            m_error = message + " at offset " + to_string(m_position);
+            return false;
+        }
+
+        const string& m_text;
+        vector<string>& m_inputPivotIds;
+        vector<ExpressionInstruction>& m_code;
+        size_t m_position = 0;
+        int m_depth = 0;
+        int m_nesting = 0;
+        bool m_tooDeep = false;
+        string m_error;
+    };
+}
+
+namespace OperationExpression {
+    /**
+     * Parse an expression and compile it to bytecode
+     *
+     * @param expression : Text of the expression
+     * @param out_inputPivotIds : Out parameter storing the pivot IDs used by the expression, each one once, in order of first use
+     * @param out_code : Out parameter storing the bytecode, ended by a Return instruction
+     * @param out_error : Out parameter storing the reason of the failure
+     * @return true if the expression is valid, else false
+     */
+    bool parse(const string& expression, vector<string>& out_inputPivotIds, vector<ExpressionInstruction>& out_code, string& out_error) {
+        out_inputPivotIds.clear();
+        out_code.clear();
+        Parser parser(expression, out_inputPivotIds, out_code);
+        return parser.parse(out_error);
+    }
+
+    /**
+     * Evaluate the bytecode of an expression
+     *
+     * @param code : First instruction of the bytecode
+     * @param inputPivotIndexes : Dense pivot indexes of the inputs of the expression, in the order returned by parse
+     * @param inputStates : Last known state of the inputs
+     * @return The result of the expression (PointState)
+     */
+    int evaluate(const ExpressionInstruction* code, const int* inputPivotIndexes, const InputStateTable& inputStates) {
+        int8_t stack[MaxStackDepth];
+        int top = 0;
+        for (const ExpressionInstruction* instruction = code ; ; ++instruction) {
+            switch (instruction->opcode) {
+                case ExpressionInstruction::Input:
+                    stack[top++] = static_cast<int8_t>(inputStates.getValue(inputPivotIndexes[instruction->operand]));
+                    break;
+                case ExpressionInstruction::Not:
+                    stack[top - 1] = notTable[stack[top - 1]];
+                    break;
+                case ExpressionInstruction::And:
+                    top--;
+                    stack[top - 1] = andTable[stack[top - 1]][stack[top]];
+                    break;
+                case ExpressionInstruction::Or:
+                    top--;
+                    stack[top - 1] = orTable[stack[top - 1]][stack[top]];
+                    break;
+                case ExpressionInstruction::Xor:
+                    top--;
+                    stack[top - 1] = xorTable[stack[top - 1]][stack[top]];
+                    break;
+                case ExpressionInstruction::Count: {
+                    top -= instruction->argumentCount;
+                    uint64_t counts = 0;
+                    for (int i = 0 ; i < instruction->argumentCount ; i++) {
+                        counts += StateCounts::unit(stack[top + i]);
+                    }
+                    int result = StateCounts::evaluateThreshold(counts, instruction->operand);
+                    if (instruction->comparison == ExpressionInstruction::Equal || instruction->comparison == ExpressionInstruction::NotEqual) {
+                        result = andTable[result][notTable[StateCounts::evaluateThreshold(counts, instruction->operand + 1)]];
+                    }
+                    if (instruction->comparison != ExpressionInstruction::GreaterOrEqual && instruction->comparison != ExpressionInstruction::Equal) {
+                        result = notTable[result];
+                    }
+                    stack[top++] = static_cast<int8_t>(result);
+                    break;
+                }
+                default:
+                    return stack[top - 1];
+            }
+        }
+    }
+};
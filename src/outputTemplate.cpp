@@ -0,0 +1,181 @@
+/*
+ * Prebuilt PIVOT skeleton used to generate output readings
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "constantsOperation.h"
+#include "outputTemplate.h"
+#include "pivotQuality.h"
+#include "pivotTimestamp.h"
+#include "pointState.h"
+
+#include <datapoint_utility.h>
+
+using namespace std;
+using namespace DatapointUtility;
+
+namespace {
+    /**
+     * Append to a list of datapoints a copy of all the given datapoints except the skipped ones
+     *
+     * @param out_dest : List of datapoints to complete
+     * @param src : Datapoints to copy
+     * @param skipName : Name of a datapoint that must not be copied
+     * @param skipDict : Dict of a datapoint that must not be copied (can be null)
+     */
+    void appendCopies(Datapoints* out_dest, const Datapoints* src, const string& skipName, const Datapoints* skipDict) {
+        for (Datapoint* dp : *src) {
+            if (dp->getName() == skipName) {
+                continue;
+            }
+            DatapointValue& data = dp->getData();
+            if (skipDict != nullptr && data.getType() == DatapointValue::T_DP_DICT && data.getDpVec() == skipDict) {
+                continue;
+            }
+            out_dest->push_back(new Datapoint(*dp));
+        }
+    }
+}
+
+/**
+ * Build the skeletons of an output datapoint
+ *
+ * @param outputPivotId : Pivot ID of the output, written in GTIS.Identifier
+ * @param outputPivotType : Pivot type of the output (SpsTyp or DpsTyp)
+ */
+OutputTemplate::OutputTemplate(const string& outputPivotId, const string& outputPivotType):
+    m_pivotType(outputPivotType),
+    m_typeSps(outputPivotType == ConstantsOperation::JsonCdcSps)
+{
+    bool typeSps = m_typeSps;
+    for (int value = 0 ; value < PointState::StateCount ; value++) {
+        Datapoints *pivotChildren = new Datapoints;
+        DatapointValue pivotValue(pivotChildren, true);
+        auto root = new Datapoint(ConstantsOperation::KeyMessagePivotJsonRoot, pivotValue);
+
+        Datapoints *dpGtis = createDictElement(root->getData().getDpVec(), ConstantsOperation::KeyMessagePivotJsonGt)->getData().getDpVec();
+        createStringElement(dpGtis, ConstantsOperation::KeyMessagePivotJsonId, outputPivotId);
+        Datapoints *dpTyp = createDictElement(dpGtis, outputPivotType)->getData().getDpVec();
+        if (typeSps) {
+            // A SPS has no intermediate or bad state, it is only on when the computed state is on
+            createIntegerElement(dpTyp, ConstantsOperation::KeyMessagePivotJsonStVal, value == PointState::StateOn ? 1 : 0);
+        }
+        else {
+            createStringElement(dpTyp, ConstantsOperation::KeyMessagePivotJsonStVal, PointState::encodeDps(value));
+        }
+        Datapoints *dpQ = createDictElement(dpTyp, ConstantsOperation::KeyMessagePivotJsonQ)->getData().getDpVec();
+        createStringElement(dpQ, ConstantsOperation::KeyMessagePivotJsonSource, ConstantsOperation::ValueSubstituted);
+
+        m_skeletons.push_back(root);
+    }
+}
+
+OutputTemplate::~OutputTemplate() {
+    for (Datapoint* root : m_skeletons) {
+        delete root;
+    }
+}
+
+/**
+ * Generate the PIVOT datapoint of an output
+ * Fixed parts come from the skeleton matching the value, every other attribute of the input
+ * (quality, timestamp, cause, ...) is copied as is, except q.Source which is always "substituted"
+ * and the attributes replaced by the given ones
+ *
+ * @param value : Computed state of the output (PointState)
+ * @param input : Elements of the input reading that triggered the output
+ * @param attributes : Quality and timestamp written instead of the ones of the input
+ * @return The new PIVOT datapoint
+ */
+Datapoint *OutputTemplate::instantiate(int value, const PivotReadingView& input, const OutputAttributes& attributes) const {
+    auto root = new Datapoint(*m_skeletons[value & 0x03]);
+    Datapoints *rootChildren = root->getData().getDpVec();
+    Datapoints *dpGtis = (*rootChildren)[PosGtis]->getData().getDpVec();
+    Datapoints *dpTyp = (*dpGtis)[PosCdc]->getData().getDpVec();
+    Datapoints *dpQ = (*dpTyp)[PosQ]->getData().getDpVec();
+
+    if (input.cdc != nullptr) {
+        Datapoints *inputQ = findDictElement(input.cdc, ConstantsOperation::KeyMessagePivotJsonQ);
+        if (attributes.replaceQuality) {
+            PivotQuality::apply(dpQ, attributes.quality);
+        }
+        else if (inputQ != nullptr) {
+            appendCopies(dpQ, inputQ, ConstantsOperation::KeyMessagePivotJsonSource, nullptr);
+        }
+        appendCopies(dpTyp, input.cdc, ConstantsOperation::KeyMessagePivotJsonStVal, inputQ);
+    }
+    if (attributes.replaceTimestamp) {
+        PivotTimestamp::apply(dpTyp, attributes.timestamp);
+    }
+    if (input.gtis != nullptr) {
+        appendCopies(dpGtis, input.gtis, ConstantsOperation::KeyMessagePivotJsonId, input.cdc);
+    }
+    if (input.pivot != nullptr) {
+        appendCopies(rootChildren, input.pivot, ConstantsOperation::KeyMessagePivotJsonGt, nullptr);
+    }
+    return root;
+}
+
+/**
+ * Rewrite the PIVOT datapoint of a reading of the output itself, instead of generating a new one
+ * Only the CDC name, stVal, q.Source and the quality and timestamp attributes when they are replaced
+ * are changed, every other attribute is kept as is
+ *
+ * @param value : Computed state of the output (PointState)
+ * @param input : Elements of the input reading to rewrite
+ * @param attributes : Quality and timestamp written instead of the ones of the input
+ * @return true if the reading was rewritten, false if its CDC could not be found
+ */
+bool OutputTemplate::rewrite(int value, const PivotReadingView& input, const OutputAttributes& attributes) const {
+    if (input.gtis == nullptr || input.cdc == nullptr) {
+        return false;
+    }
+    Datapoint *dpCdc = nullptr;
+    for (Datapoint* dp : *input.gtis) {
+        DatapointValue& data = dp->getData();
+        if (data.getType() == DatapointValue::T_DP_DICT && data.getDpVec() == input.cdc) {
+            dpCdc = dp;
+            break;
+        }
+    }
+    if (dpCdc == nullptr) {
+        return false;
+    }
+    if (dpCdc->getName() != m_pivotType) {
+        dpCdc->setName(m_pivotType);
+    }
+
+    Datapoint *dpStVal = findDatapointElement(input.cdc, ConstantsOperation::KeyMessagePivotJsonStVal);
+    if (dpStVal == nullptr) {
+        dpStVal = m_typeSps ? createIntegerElement(input.cdc, ConstantsOperation::KeyMessagePivotJsonStVal, 0)
+                            : createStringElement(input.cdc, ConstantsOperation::KeyMessagePivotJsonStVal, "");
+    }
+    if (m_typeSps) {
+        dpStVal->getData() = DatapointValue(static_cast<long>(value == PointState::StateOn ? 1 : 0));
+    }
+    else {
+        dpStVal->getData() = DatapointValue(PointState::encodeDps(value));
+    }
+
+    Datapoints *dpQ = findDictElement(input.cdc, ConstantsOperation::KeyMessagePivotJsonQ);
+    if (dpQ == nullptr) {
+        dpQ = createDictElement(input.cdc, ConstantsOperation::KeyMessagePivotJsonQ)->getData().getDpVec();
+    }
+    Datapoint *dpSource = findDatapointElement(dpQ, ConstantsOperation::KeyMessagePivotJsonSource);
+    if (dpSource == nullptr) {
+        createStringElement(dpQ, ConstantsOperation::KeyMessagePivotJsonSource, ConstantsOperation::ValueSubstituted);
+    }
+    else {
+        dpSource->getData() = DatapointValue(ConstantsOperation::ValueSubstituted);
+    }
+    if (attributes.replaceQuality) {
+        PivotQuality::apply(dpQ, attributes.quality);
+    }
+    if (attributes.replaceTimestamp) {
+        PivotTimestamp::apply(input.cdc, attributes.timestamp);
+    }
+    return true;
+}
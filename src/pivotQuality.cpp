@@ -0,0 +1,130 @@
+/*
+ * Compact form of the quality (q) of a PIVOT datapoint
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "constantsOperation.h"
+#include "pivotQuality.h"
+
+#include <datapoint_utility.h>
+
+#include <string>
+
+using namespace std;
+using namespace DatapointUtility;
+
+namespace {
+    // DetailQuality flags, in the order of their bits
+    const string detailQualityNames[] = {"overflow", "outOfRange", "badReference", "oscillatory",
+                                         "failure", "oldData", "inconsistent", "inaccurate"};
+
+    /**
+     * Read a boolean flag of the quality, given either as an integer or as a string
+     */
+    bool isFlagSet(const DatapointValue& value) {
+        if (value.getType() == DatapointValue::T_INTEGER) {
+            return value.toInt() != 0;
+        }
+        if (value.getType() == DatapointValue::T_STRING) {
+            string flag = value.toStringValue();
+            return flag == "true" || flag == "1";
+        }
+        return false;
+    }
+}
+
+namespace PivotQuality {
+    /**
+     * Pack the quality of a PIVOT datapoint
+     *
+     * @param q : Children of the q element (can be null, then the quality is good)
+     * @return The quality mask
+     */
+    uint16_t encode(const vector<Datapoint*>* q) {
+        uint16_t mask = ValidityGood;
+        if (q == nullptr) {
+            return mask;
+        }
+        for (Datapoint* dp : *q) {
+            const string& name = dp->getName();
+            DatapointValue& value = dp->getData();
+            if (name == ConstantsOperation::KeyMessagePivotJsonValidity) {
+                if (value.getType() != DatapointValue::T_STRING) {
+                    continue;
+                }
+                string validity = value.toStringValue();
+                if (validity == "invalid" || validity == "reserved") {
+                    mask |= ValidityInvalid;
+                }
+                else if (validity == "questionable") {
+                    mask |= ValidityQuestionable;
+                }
+            }
+            else if (name == ConstantsOperation::KeyMessagePivotJsonDetailQuality) {
+                if (value.getType() != DatapointValue::T_DP_DICT) {
+                    continue;
+                }
+                for (Datapoint* detail : *value.getDpVec()) {
+                    const string& detailName = detail->getName();
+                    for (uint16_t bit = 0 ; bit < 8 ; bit++) {
+                        // "inacurate" is also accepted, as spelled by some protocol plugins
+                        if ((detailName == detailQualityNames[bit] || (bit == 7 && detailName == "inacurate")) && isFlagSet(detail->getData())) {
+                            mask |= static_cast<uint16_t>(1 << (bit + DetailQualityShift));
+                        }
+                    }
+                }
+            }
+            else if (name == ConstantsOperation::KeyMessagePivotJsonTest) {
+                if (isFlagSet(value)) {
+                    mask |= TestFlag;
+                }
+            }
+            else if (name == ConstantsOperation::KeyMessagePivotJsonOperatorBlocked) {
+                if (isFlagSet(value)) {
+                    mask |= OperatorBlockedFlag;
+                }
+            }
+        }
+        return mask;
+    }
+
+    /**
+     * Write a quality mask in the q element of a PIVOT datapoint
+     * Attributes of the mask are replaced, other attributes (Source) are kept
+     *
+     * @param q : Children of the q element
+     * @param mask : The quality mask
+     */
+    void apply(vector<Datapoint*>* q, uint16_t mask) {
+        const char *validity = "good";
+        if (mask & ValidityInvalid) {
+            validity = "invalid";
+        }
+        else if (mask & ValidityQuestionable) {
+            validity = "questionable";
+        }
+        createStringElement(q, ConstantsOperation::KeyMessagePivotJsonValidity, validity);
+
+        deleteValue(q, ConstantsOperation::KeyMessagePivotJsonDetailQuality);
+        if (mask & DetailQualityMask) {
+            Datapoints *dpDetailQuality = createDictElement(q, ConstantsOperation::KeyMessagePivotJsonDetailQuality)->getData().getDpVec();
+            for (uint16_t bit = 0 ; bit < 8 ; bit++) {
+                if (mask & (1 << (bit + DetailQualityShift))) {
+                    createIntegerElement(dpDetailQuality, detailQualityNames[bit], 1);
+                }
+            }
+        }
+
+        deleteValue(q, ConstantsOperation::KeyMessagePivotJsonTest);
+        if (mask & TestFlag) {
+            createIntegerElement(q, ConstantsOperation::KeyMessagePivotJsonTest, 1);
+        }
+        deleteValue(q, ConstantsOperation::KeyMessagePivotJsonOperatorBlocked);
+        if (mask & OperatorBlockedFlag) {
+            createIntegerElement(q, ConstantsOperation::KeyMessagePivotJsonOperatorBlocked, 1);
+        }
+    }
+};
@@ -0,0 +1,73 @@
+/*
+ * Compact form of the timestamp (t) of a PIVOT datapoint
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "constantsOperation.h"
+#include "pivotTimestamp.h"
+
+#include <datapoint_utility.h>
+
+using namespace std;
+using namespace DatapointUtility;
+
+namespace PivotTimestamp {
+    /**
+     * Read the packed timestamp of a CDC element
+     *
+     * @param cdc : Children of the CDC element (SpsTyp or DpsTyp)
+     * @return The packed timestamp, 0 if the CDC has no timestamp
+     */
+    uint64_t read(vector<Datapoint*>* cdc) {
+        Datapoints *dpT = findDictElement(cdc, ConstantsOperation::KeyMessagePivotJsonT);
+        if (dpT == nullptr) {
+            return 0;
+        }
+        long seconds = 0;
+        long fraction = 0;
+        for (Datapoint* dp : *dpT) {
+            DatapointValue& value = dp->getData();
+            if (value.getType() != DatapointValue::T_INTEGER) {
+                continue;
+            }
+            const string& name = dp->getName();
+            if (name == ConstantsOperation::KeyMessagePivotJsonSecondSinceEpoch) {
+                seconds = value.toInt();
+            }
+            else if (name == ConstantsOperation::KeyMessagePivotJsonFractSec) {
+                fraction = value.toInt();
+            }
+        }
+        return pack(seconds, fraction);
+    }
+
+    /**
+     * Write a packed timestamp in a CDC element, other attributes of t (TimeQuality, ...) are kept
+     *
+     * @param cdc : Children of the CDC element (SpsTyp or DpsTyp)
+     * @param timestamp : Packed timestamp to write
+     */
+    void apply(vector<Datapoint*>* cdc, uint64_t timestamp) {
+        Datapoints *dpT = findDictElement(cdc, ConstantsOperation::KeyMessagePivotJsonT);
+        if (dpT == nullptr) {
+            dpT = createDictElement(cdc, ConstantsOperation::KeyMessagePivotJsonT)->getData().getDpVec();
+        }
+        Datapoint *dpSeconds = findDatapointElement(dpT, ConstantsOperation::KeyMessagePivotJsonSecondSinceEpoch);
+        if (dpSeconds == nullptr) {
+            createIntegerElement(dpT, ConstantsOperation::KeyMessagePivotJsonSecondSinceEpoch, seconds(timestamp));
+        }
+        else {
+            dpSeconds->getData() = DatapointValue(seconds(timestamp));
+        }
+        Datapoint *dpFraction = findDatapointElement(dpT, ConstantsOperation::KeyMessagePivotJsonFractSec);
+        if (dpFraction == nullptr) {
+            createIntegerElement(dpT, ConstantsOperation::KeyMessagePivotJsonFractSec, fraction(timestamp));
+        }
+        else {
+            dpFraction->getData() = DatapointValue(fraction(timestamp));
+        }
+    }
+};
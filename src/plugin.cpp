@@ -26,6 +26,108 @@ static const char* default_config = QUOTE({
             "type" : "boolean",
             "default" : "true"
             },
+        "emit_policy": {
+            "description": "When the readings of the computed datapoints are generated: for every input reading involved (always), only when the computed value changes (on-change), or when the computed value or the quality of the input changes (on-change-or-quality-change)",
+            "displayName" : "Emit policy",
+            "type" : "enumeration",
+            "options" : ["always", "on-change", "on-change-or-quality-change"],
+            "default" : "always",
+            "order" : "4"
+            },
+        "coalesce_outputs": {
+            "description": "Evaluate all the readings of a reading set before generating the computed datapoints, so that at most one reading per operation is generated with the final value and the newest input timestamp",
+            "displayName" : "Coalesce outputs",
+            "type" : "boolean",
+            "default" : "false",
+            "order" : "5"
+            },
+        "quality_policy": {
+            "description": "Quality of the computed datapoints: quality of the input that triggered the operation (trigger), worst quality of all the inputs (worst_of), or worst quality of the inputs whose state is the result of the operation (contributing, all the inputs for not, xor and expressions)",
+            "displayName" : "Quality policy",
+            "type" : "enumeration",
+            "options" : ["trigger", "worst_of", "contributing"],
+            "default" : "trigger",
+            "order" : "6"
+            },
+        "timestamp_policy": {
+            "description": "Timestamp of the computed datapoints: timestamp of the input that triggered the operation (trigger), newest timestamp of all the inputs (max_of_inputs), or newest timestamp of the inputs whose state is the result of the operation (max_of_contributing_inputs, all the inputs for not, xor and expressions)",
+            "displayName" : "Timestamp policy",
+            "type" : "enumeration",
+            "options" : ["trigger", "max_of_inputs", "max_of_contributing_inputs"],
+            "default" : "trigger",
+            "order" : "7"
+            },
+        "reject_out_of_order": {
+            "description": "Ignore the readings of an input older than the last one received for this input",
+            "displayName" : "Reject out of order readings",
+            "type" : "boolean",
+            "default" : "false",
+            "order" : "8"
+            },
+        "state_file": {
+            "description": "Path of the file where the state of the inputs is saved (with a journal of the changes next to it), so that it is restored when the filter is started again. Empty to disable",
+            "displayName" : "State file",
+            "type" : "string",
+            "default" : "",
+            "order" : "9"
+            },
+        "state_max_age": {
+            "description": "Input states restored from the state file older than this number of seconds are ignored, 0 to restore them all",
+            "displayName" : "Maximum age of restored states",
+            "type" : "integer",
+            "default" : "0",
+            "order" : "10"
+            },
+        "state_flush_interval": {
+            "description": "Milliseconds between two writes of the changes of the input states to the state file, the changes of the last interval are lost if the system crashes. 0 to write them after each reading set",
+            "displayName" : "State file flush interval",
+            "type" : "integer",
+            "default" : "1000",
+            "order" : "17"
+            },
+        "unknown_input_policy": {
+            "description": "Output of an operation when some of its inputs were never received: computed with these inputs off (assume_off), not generated (withhold), or generated with a questionable validity (questionable)",
+            "displayName" : "Unknown input policy",
+            "type" : "enumeration",
+            "options" : ["assume_off", "withhold", "questionable"],
+            "default" : "assume_off",
+            "order" : "11"
+            },
+        "known_inputs_ratio": {
+            "description": "Fraction of the inputs of an operation that must have been received for its output not to be affected by the unknown input policy, between 0 (excluded) and 1",
+            "displayName" : "Known inputs ratio",
+            "type" : "float",
+            "default" : "1.0",
+            "order" : "12"
+            },
+        "worker_threads": {
+            "description": "Number of threads processing in parallel the readings of operations that share no input, used for large reading sets when outputs are not coalesced. 0 or 1 to process all the readings in the ingest thread",
+            "displayName" : "Worker threads",
+            "type" : "integer",
+            "default" : "0",
+            "order" : "13"
+            },
+        "metrics_interval": {
+            "description": "Number of seconds between two readings of the metrics of the filter (counters of the readings processed and latency histograms), added to the reading set being processed. 0 to disable",
+            "displayName" : "Metrics interval",
+            "type" : "integer",
+            "default" : "0",
+            "order" : "14"
+            },
+        "metrics_asset": {
+            "description": "Asset name of the readings of the metrics of the filter",
+            "displayName" : "Metrics asset",
+            "type" : "string",
+            "default" : "spoperators_metrics",
+            "order" : "15"
+            },
+        "operation_stats": {
+            "description": "Count the evaluations, generated and suppressed outputs and processing time of each operation (updates of its inputs, evaluation and output readings). The most expensive outputs are listed in the metrics reading",
+            "displayName" : "Operation statistics",
+            "type" : "boolean",
+            "default" : "false",
+            "order" : "16"
+            },
         "exchanged_data" : {
             "description" : "exchanged data list",
             "type" : "JSON",
@@ -0,0 +1,50 @@
+/*
+ * States of the status points and count of the inputs of an operation in each state
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "pointState.h"
+
+using namespace std;
+
+namespace {
+    // stVal of a DPS for each state
+    const string dpsValues[PointState::StateCount] = {"off", "on", "intermediate-state", "bad-state"};
+}
+
+namespace PointState {
+    /**
+     * Decode the stVal of a DPS, dispatching on its length so that a single string comparison is done
+     *
+     * @param stVal : stVal of the DPS
+     * @return The state of the DPS, StateBad if stVal is not a DPS value
+     */
+    int decodeDps(const string& stVal) {
+        int state = StateBad;
+        switch (stVal.size()) {
+            case 2:
+                state = StateOn;
+                break;
+            case 3:
+                state = StateOff;
+                break;
+            case 18:
+                state = StateIntermediate;
+                break;
+            default:
+                break;
+        }
+        return stVal == dpsValues[state] ? state : StateBad;
+    }
+
+    /**
+     * @param state : State of a DPS
+     * @return The stVal of the DPS
+     */
+    const string& encodeDps(int state) {
+        return dpsValues[state & 0x03];
+    }
+};
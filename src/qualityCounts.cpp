@@ -0,0 +1,84 @@
+/*
+ * Incremental aggregation of the qualities of the inputs of the operations
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "qualityCounts.h"
+
+#include <algorithm>
+
+/**
+ * Size the counters for a number of operations, all inputs having a good quality
+ *
+ * @param operationCount : Number of compiled operations
+ */
+void QualityCounts::reset(std::size_t operationCount) {
+    m_bitCounts.assign(operationCount * PointState::StateCount * PivotQuality::BitCount, 0);
+    m_masks.assign(operationCount * PointState::StateCount, 0);
+}
+
+void QualityCounts::swap(QualityCounts& other) {
+    m_bitCounts.swap(other.m_bitCounts);
+    m_masks.swap(other.m_masks);
+}
+
+/**
+ * Count the quality of an input of an operation
+ *
+ * @param operationIndex : Index of the compiled operation
+ * @param state : State of the input (PointState)
+ * @param quality : Quality mask of the input
+ */
+void QualityCounts::add(int operationIndex, int state, uint16_t quality) {
+    std::size_t slot = static_cast<std::size_t>(operationIndex) * PointState::StateCount + state;
+    uint32_t *bitCounts = &m_bitCounts[slot * PivotQuality::BitCount];
+    while (quality != 0) {
+        int bit = __builtin_ctz(quality);
+        quality &= static_cast<uint16_t>(quality - 1);
+        if (bitCounts[bit]++ == 0) {
+            m_masks[slot] |= static_cast<uint16_t>(1 << bit);
+        }
+    }
+}
+
+/**
+ * Remove the quality of an input of an operation, previously counted with the same state and quality
+ *
+ * @param operationIndex : Index of the compiled operation
+ * @param state : State of the input (PointState)
+ * @param quality : Quality mask of the input
+ */
+void QualityCounts::remove(int operationIndex, int state, uint16_t quality) {
+    std::size_t slot = static_cast<std::size_t>(operationIndex) * PointState::StateCount + state;
+    uint32_t *bitCounts = &m_bitCounts[slot * PivotQuality::BitCount];
+    while (quality != 0) {
+        int bit = __builtin_ctz(quality);
+        quality &= static_cast<uint16_t>(quality - 1);
+        if (--bitCounts[bit] == 0) {
+            m_masks[slot] &= static_cast<uint16_t>(~(1 << bit));
+        }
+    }
+}
+
+/**
+ * Copy the counters of an operation of another instance
+ *
+ * @param operationIndex : Index of the compiled operation in this instance
+ * @param other : Instance to copy from
+ * @param otherIndex : Index of the compiled operation in the other instance
+ */
+void QualityCounts::copyOperation(int operationIndex, const QualityCounts& other, int otherIndex) {
+    const std::size_t countsPerOperation = PointState::StateCount * PivotQuality::BitCount;
+    auto first = other.m_bitCounts.begin() + otherIndex * countsPerOperation;
+    std::copy(first, first + countsPerOperation, m_bitCounts.begin() + operationIndex * countsPerOperation);
+    auto firstMask = other.m_masks.begin() + otherIndex * PointState::StateCount;
+    std::copy(firstMask, firstMask + PointState::StateCount, m_masks.begin() + operationIndex * PointState::StateCount);
+}
+
+uint16_t QualityCounts::getWorstMask(int operationIndex) const {
+    const uint16_t *masks = &m_masks[static_cast<std::size_t>(operationIndex) * PointState::StateCount];
+    return static_cast<uint16_t>(masks[0] | masks[1] | masks[2] | masks[3]);
+}
@@ -0,0 +1,435 @@
+/*
+ * Persistence of the state of the inputs on local disk, for warm restarts
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "constantsOperation.h"
+#include "stateStore.h"
+#include "utilityOperation.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    const char SnapshotMagic[8] = {'S', 'P', 'O', 'S', 'N', 'A', 'P', '1'};
+    const char JournalMagic[8] = {'S', 'P', 'O', 'J', 'R', 'N', 'L', '1'};
+    // Magic, generation, write time and entry count
+    const size_t SnapshotHeaderSize = 32;
+    const size_t SnapshotEntryCountOffset = 24;
+    // Magic and generation
+    const size_t JournalHeaderSize = 16;
+    // Entry without the pivot ID: ID length, state, quality, timestamp and checksum
+    const size_t EntryFixedSize = 2 + 1 + 2 + 8 + 4;
+    // Buffered snapshot entries are written by blocks of this size
+    const size_t SnapshotBlockSize = 1 << 20;
+
+    template <typename T>
+    void appendValue(vector<char>& out_buffer, T value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out_buffer.insert(out_buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    T readValue(const char* data) {
+        T value;
+        memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    // FNV-1a hash of the bytes of an entry
+    uint32_t checksum(const char* data, size_t size) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0 ; i < size ; i++) {
+            hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    /**
+     * Read-only memory mapping of a whole file
+     */
+    class MappedFile {
+    public:
+        explicit MappedFile(int fd) {
+            struct stat fileStat;
+            if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+                return;
+            }
+            void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                return;
+            }
+            m_data = static_cast<const char*>(data);
+            m_size = static_cast<size_t>(fileStat.st_size);
+        }
+        ~MappedFile() {
+            if (m_data != nullptr) {
+                munmap(const_cast<char*>(m_data), m_size);
+            }
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* data() const { return m_data; }
+        size_t size() const { return m_size; }
+
+    private:
+        const char* m_data = nullptr;
+        size_t m_size = 0;
+    };
+}
+
+StateStore::~StateStore() {
+    close();
+}
+
+/**
+ * Open the files of the store and read the state they contain
+ * The journal is replayed on top of the snapshot, a torn record at its end is removed from the file
+ *
+ * @param path : Path of the snapshot, the journal is stored next to it
+ * @param out_inputs : Out parameter storing the state of each pivot ID found
+ * @param out_snapshotTime : Out parameter storing the time the snapshot was written (seconds since epoch, 0 if none)
+ * @return true if the journal could be opened for writing, else false
+ */
+bool StateStore::open(const string& path, unordered_map<string, PersistedInput>& out_inputs, uint64_t& out_snapshotTime) {
+    close();
+    m_path = path;
+    out_inputs.clear();
+    out_snapshotTime = 0;
+    m_generation = 0;
+    loadSnapshot(out_inputs, out_snapshotTime);
+
+    string journalPath = m_path + ".journal";
+    m_journalFd = ::open(journalPath.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (m_journalFd < 0) {
+        UtilityOperation::log_error("%s - StateStore::open : Unable to open %s: %s", ConstantsOperation::NamePlugin.c_str(),
+                                    journalPath.c_str(), strerror(errno));
+        return false;
+    }
+    size_t validSize = loadJournal(out_inputs);
+    if (validSize == 0) {
+        if (!resetJournal()) {
+            close();
+            return false;
+        }
+    }
+    else if (ftruncate(m_journalFd, static_cast<off_t>(validSize)) != 0) {
+        // Records appended after a torn end would be dropped by the next open, the state cannot be saved
+        UtilityOperation::log_error("%s - StateStore::open : Unable to remove the torn end of %s, state is not saved: %s", ConstantsOperation::NamePlugin.c_str(),
+                                    journalPath.c_str(), strerror(errno));
+        close();
+        return false;
+    }
+    UtilityOperation::log_info("%s - StateStore::open : State of %zu inputs read from %s (%zu journal records)", ConstantsOperation::NamePlugin.c_str(),
+                               out_inputs.size(), m_path.c_str(), m_journalRecordCount);
+    return true;
+}
+
+/**
+ * Write the buffered changes and close the files
+ */
+void StateStore::close() {
+    if (m_snapshotFd >= 0) {
+        ::close(m_snapshotFd);
+        m_snapshotFd = -1;
+        unlink((m_path + ".tmp").c_str());
+    }
+    if (m_journalFd >= 0) {
+        flush();
+        ::close(m_journalFd);
+        m_journalFd = -1;
+    }
+    m_journalBuffer.clear();
+    m_snapshotBuffer.clear();
+    m_journalRecordCount = 0;
+}
+
+/**
+ * Add a change of an input to the journal, it is only written to disk by the next flush
+ *
+ * @param pivotId : Pivot ID of the input
+ * @param input : New state of the input
+ */
+void StateStore::record(const string& pivotId, const PersistedInput& input) {
+    appendEntry(m_journalBuffer, pivotId, input);
+    m_journalRecordCount++;
+}
+
+/**
+ * Write the buffered changes to the journal and wait until they reach the disk
+ *
+ * @return true if the changes were written, else false (they are kept for the next flush)
+ */
+bool StateStore::flush() {
+    if (m_journalFd < 0 || m_journalBuffer.empty()) {
+        return true;
+    }
+    if (!writeAll(m_journalFd, m_journalBuffer.data(), m_journalBuffer.size()) || fdatasync(m_journalFd) != 0) {
+        UtilityOperation::log_error("%s - StateStore::flush : Unable to write %s.journal: %s", ConstantsOperation::NamePlugin.c_str(),
+                                    m_path.c_str(), strerror(errno));
+        return false;
+    }
+    m_journalBuffer.clear();
+    return true;
+}
+
+/**
+ * Start writing a new snapshot, entries are then given to addSnapshotEntry and the snapshot replaces the current one on commitSnapshot
+ *
+ * @return true if the snapshot file could be created, else false
+ */
+bool StateStore::beginSnapshot() {
+    if (m_journalFd < 0) {
+        return false;
+    }
+    if (m_snapshotFd >= 0) {
+        ::close(m_snapshotFd);
+    }
+    string snapshotPath = m_path + ".tmp";
+    m_snapshotFd = ::open(snapshotPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_snapshotFd < 0) {
+        UtilityOperation::log_error("%s - StateStore::beginSnapshot : Unable to create %s: %s", ConstantsOperation::NamePlugin.c_str(),
+                                    snapshotPath.c_str(), strerror(errno));
+        return false;
+    }
+    m_snapshotEntryCount = 0;
+    m_snapshotBuffer.clear();
+    m_snapshotBuffer.insert(m_snapshotBuffer.end(), SnapshotMagic, SnapshotMagic + sizeof(SnapshotMagic));
+    appendValue<uint64_t>(m_snapshotBuffer, m_generation + 1);
+    appendValue<uint64_t>(m_snapshotBuffer, static_cast<uint64_t>(time(nullptr)));
+    // Entry count, written by commitSnapshot
+    appendValue<uint64_t>(m_snapshotBuffer, 0);
+    return true;
+}
+
+/**
+ * Add the state of an input to the snapshot being written
+ *
+ * @param pivotId : Pivot ID of the input
+ * @param input : State of the input
+ */
+void StateStore::addSnapshotEntry(const string& pivotId, const PersistedInput& input) {
+    if (m_snapshotFd < 0) {
+        return;
+    }
+    appendEntry(m_snapshotBuffer, pivotId, input);
+    m_snapshotEntryCount++;
+    if (m_snapshotBuffer.size() >= SnapshotBlockSize) {
+        if (!writeAll(m_snapshotFd, m_snapshotBuffer.data(), m_snapshotBuffer.size())) {
+            UtilityOperation::log_error("%s - StateStore::addSnapshotEntry : Unable to write %s.tmp: %s", ConstantsOperation::NamePlugin.c_str(),
+                                        m_path.c_str(), strerror(errno));
+            ::close(m_snapshotFd);
+            m_snapshotFd = -1;
+        }
+        m_snapshotBuffer.clear();
+    }
+}
+
+/**
+ * Replace the current snapshot by the one written since beginSnapshot and start a new journal
+ * The changes still buffered for the journal are dropped as the snapshot contains them
+ *
+ * @return true if the snapshot was replaced and a new journal started, else false: either the current snapshot and journal
+ * are kept, or the journal could not be reset and the store is closed
+ */
+bool StateStore::commitSnapshot() {
+    if (m_snapshotFd < 0) {
+        return false;
+    }
+    string snapshotPath = m_path + ".tmp";
+    bool written = writeAll(m_snapshotFd, m_snapshotBuffer.data(), m_snapshotBuffer.size())
+                   && pwrite(m_snapshotFd, &m_snapshotEntryCount, sizeof(m_snapshotEntryCount), SnapshotEntryCountOffset) == sizeof(m_snapshotEntryCount)
+                   && fdatasync(m_snapshotFd) == 0;
+    m_snapshotBuffer.clear();
+    ::close(m_snapshotFd);
+    m_snapshotFd = -1;
+    if (!written || rename(snapshotPath.c_str(), m_path.c_str()) != 0) {
+        UtilityOperation::log_error("%s - StateStore::commitSnapshot : Unable to write %s: %s", ConstantsOperation::NamePlugin.c_str(),
+                                    m_path.c_str(), strerror(errno));
+        unlink(snapshotPath.c_str());
+        return false;
+    }
+    // The rename itself must reach the disk before the journal is reset
+    size_t separator = m_path.rfind('/');
+    string directory = separator == string::npos ? "." : (separator == 0 ? "/" : m_path.substr(0, separator));
+    int directoryFd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (directoryFd >= 0) {
+        fsync(directoryFd);
+        ::close(directoryFd);
+    }
+
+    m_generation++;
+    m_journalBuffer.clear();
+    m_journalRecordCount = 0;
+    // A journal left from the previous generation is ignored on open: the changes appended to it would be lost,
+    // so the state is no longer saved (the new snapshot already holds every change up to now)
+    if (!resetJournal()) {
+        UtilityOperation::log_error("%s - StateStore::commitSnapshot : Journal of %s not reset, state is no longer saved", ConstantsOperation::NamePlugin.c_str(),
+                                    m_path.c_str());
+        close();
+        return false;
+    }
+    SPOPERATORS_LOG_DEBUG("%s - StateStore::commitSnapshot : State of %llu inputs written to %s", ConstantsOperation::NamePlugin.c_str(),
+                          static_cast<unsigned long long>(m_snapshotEntryCount), m_path.c_str());
+    return true;
+}
+
+/**
+ * Append an entry (pivot ID, state and checksum) to a buffer
+ *
+ * @param out_buffer : Buffer to complete
+ * @param pivotId : Pivot ID of the input
+ * @param input : State of the input
+ */
+void StateStore::appendEntry(vector<char>& out_buffer, const string& pivotId, const PersistedInput& input) {
+    size_t begin = out_buffer.size();
+    uint16_t idLength = static_cast<uint16_t>(min<size_t>(pivotId.size(), UINT16_MAX));
+    appendValue<uint16_t>(out_buffer, idLength);
+    out_buffer.insert(out_buffer.end(), pivotId.data(), pivotId.data() + idLength);
+    appendValue<uint8_t>(out_buffer, input.state);
+    appendValue<uint16_t>(out_buffer, input.quality);
+    appendValue<uint64_t>(out_buffer, input.timestamp);
+    appendValue<uint32_t>(out_buffer, checksum(out_buffer.data() + begin, out_buffer.size() - begin));
+}
+
+/**
+ * Read an entry written by appendEntry
+ *
+ * @param data : First byte of the entry
+ * @param size : Number of bytes available
+ * @param out_pivotId : Out parameter storing the pivot ID of the input
+ * @param out_input : Out parameter storing the state of the input
+ * @return Size of the entry, 0 if it is truncated or corrupted
+ */
+size_t StateStore::readEntry(const char* data, size_t size, string& out_pivotId, PersistedInput& out_input) {
+    if (size < EntryFixedSize) {
+        return 0;
+    }
+    size_t idLength = readValue<uint16_t>(data);
+    size_t entrySize = EntryFixedSize + idLength;
+    if (size < entrySize || readValue<uint32_t>(data + entrySize - 4) != checksum(data, entrySize - 4)) {
+        return 0;
+    }
+    const char* fields = data + 2 + idLength;
+    out_pivotId.assign(data + 2, idLength);
+    out_input.state = readValue<uint8_t>(fields);
+    out_input.quality = readValue<uint16_t>(fields + 1);
+    out_input.timestamp = readValue<uint64_t>(fields + 3);
+    return entrySize;
+}
+
+/**
+ * Read the snapshot file, if any
+ *
+ * @param out_inputs : Out parameter storing the state of each pivot ID found
+ * @param out_snapshotTime : Out parameter storing the time the snapshot was written
+ * @return true if a valid snapshot was read, else false
+ */
+bool StateStore::loadSnapshot(unordered_map<string, PersistedInput>& out_inputs, uint64_t& out_snapshotTime) {
+    int fd = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    MappedFile file(fd);
+    ::close(fd);
+    if (file.size() < SnapshotHeaderSize || memcmp(file.data(), SnapshotMagic, sizeof(SnapshotMagic)) != 0) {
+        UtilityOperation::log_error("%s - StateStore::loadSnapshot : %s is not a valid state snapshot, it is ignored", ConstantsOperation::NamePlugin.c_str(),
+                                    m_path.c_str());
+        return false;
+    }
+    m_generation = readValue<uint64_t>(file.data() + 8);
+    out_snapshotTime = readValue<uint64_t>(file.data() + 16);
+    uint64_t entryCount = readValue<uint64_t>(file.data() + SnapshotEntryCountOffset);
+    out_inputs.reserve(static_cast<size_t>(min<uint64_t>(entryCount, file.size() / EntryFixedSize)));
+
+    size_t position = SnapshotHeaderSize;
+    string pivotId;
+    PersistedInput input;
+    for (uint64_t i = 0 ; i < entryCount ; i++) {
+        size_t entrySize = readEntry(file.data() + position, file.size() - position, pivotId, input);
+        if (entrySize == 0) {
+            UtilityOperation::log_error("%s - StateStore::loadSnapshot : %s is corrupted after %llu entries", ConstantsOperation::NamePlugin.c_str(),
+                                        m_path.c_str(), static_cast<unsigned long long>(i));
+            return false;
+        }
+        out_inputs[pivotId] = input;
+        position += entrySize;
+    }
+    return true;
+}
+
+/**
+ * Replay the journal on top of the snapshot, when it belongs to the same generation
+ *
+ * @param out_inputs : Out parameter storing the state of each pivot ID, updated with the changes found
+ * @return Size of the valid part of the journal, 0 if it must be reset
+ */
+size_t StateStore::loadJournal(unordered_map<string, PersistedInput>& out_inputs) {
+    MappedFile file(m_journalFd);
+    if (file.size() < JournalHeaderSize || memcmp(file.data(), JournalMagic, sizeof(JournalMagic)) != 0
+        || readValue<uint64_t>(file.data() + 8) != m_generation) {
+        return 0;
+    }
+    size_t position = JournalHeaderSize;
+    string pivotId;
+    PersistedInput input;
+    while (position < file.size()) {
+        size_t entrySize = readEntry(file.data() + position, file.size() - position, pivotId, input);
+        if (entrySize == 0) {
+            UtilityOperation::log_warn("%s - StateStore::loadJournal : Torn record at offset %zu of %s.journal, the end of the journal is ignored",
+                                       ConstantsOperation::NamePlugin.c_str(), position, m_path.c_str());
+            break;
+        }
+        out_inputs[pivotId] = input;
+        m_journalRecordCount++;
+        position += entrySize;
+    }
+    return position;
+}
+
+/**
+ * Empty the journal and write its header for the current generation
+ *
+ * @return true if the journal was reset, else false
+ */
+bool StateStore::resetJournal() {
+    vector<char> header(JournalMagic, JournalMagic + sizeof(JournalMagic));
+    appendValue<uint64_t>(header, m_generation);
+    if (ftruncate(m_journalFd, 0) != 0 || !writeAll(m_journalFd, header.data(), header.size()) || fdatasync(m_journalFd) != 0) {
+        UtilityOperation::log_error("%s - StateStore::resetJournal : Unable to write %s.journal: %s", ConstantsOperation::NamePlugin.c_str(),
+                                    m_path.c_str(), strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Write a whole buffer to a file, retrying on partial writes
+ */
+bool StateStore::writeAll(int fd, const char* data, size_t size) const {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
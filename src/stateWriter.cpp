@@ -0,0 +1,182 @@
+/*
+ * Thread writing the state of the inputs to the state store, out of the ingest critical section
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "stateWriter.h"
+
+using namespace std;
+
+const size_t StateWriter::FlushMaxRecords;
+
+StateWriter::~StateWriter() {
+    close();
+}
+
+/**
+ * Open the state store and start the thread writing to it, the store in use is closed first
+ *
+ * @param path : Path of the snapshot file
+ * @param out_inputs : Input states read from the files, by pivot ID
+ * @param out_snapshotTime : Time the snapshot read was written, in seconds since the epoch
+ * @return true if the store was opened, else false
+ */
+bool StateWriter::open(const string& path, unordered_map<string, PersistedInput>& out_inputs, uint64_t& out_snapshotTime) {
+    close();
+    if (!m_store.open(path, out_inputs, out_snapshotTime)) {
+        return false;
+    }
+    m_journalRecordCount = m_store.getJournalRecordCount();
+    m_stop = false;
+    m_open = true;
+    m_thread = thread(&StateWriter::writerLoop, this);
+    return true;
+}
+
+/**
+ * Write every task queued, flush the journal and close the store
+ */
+void StateWriter::close() {
+    if (m_thread.joinable()) {
+        {
+            lock_guard<mutex> guard(m_mutex);
+            m_stop = true;
+        }
+        m_taskQueued.notify_one();
+        m_thread.join();
+    }
+    m_store.close();
+    m_tasks.clear();
+    m_journalRecordCount = 0;
+    m_open = false;
+}
+
+/**
+ * Queue changes of input states to add to the journal
+ *
+ * @param config : Configuration giving the pivot ID of the inputs
+ * @param changes : Changes of the input states, moved to the queue
+ */
+void StateWriter::record(const shared_ptr<const ConfigOperation>& config, Changes&& changes) {
+    if (!m_open || changes.empty()) {
+        return;
+    }
+    m_journalRecordCount += changes.size();
+    Task task;
+    task.config = config;
+    task.changes = std::move(changes);
+    pushTask(std::move(task));
+}
+
+/**
+ * Queue the states of all the inputs to write in a new snapshot, replacing the journal
+ *
+ * @param config : Configuration giving the pivot ID of the inputs
+ * @param inputs : State of each input, by index in the configuration, moved to the queue
+ */
+void StateWriter::snapshot(const shared_ptr<const ConfigOperation>& config, vector<PersistedInput>&& inputs) {
+    if (!m_open) {
+        return;
+    }
+    m_journalRecordCount = 0;
+    Task task;
+    task.config = config;
+    task.isSnapshot = true;
+    task.inputs = std::move(inputs);
+    pushTask(std::move(task));
+}
+
+void StateWriter::pushTask(Task&& task) {
+    {
+        lock_guard<mutex> guard(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_taskQueued.notify_one();
+}
+
+/**
+ * Main loop of the thread: write the queued tasks, and flush the journal when the flush interval elapsed since
+ * the oldest change not flushed, until the writer is closed
+ */
+void StateWriter::writerLoop() {
+    size_t bufferedRecords = 0;
+    chrono::steady_clock::time_point flushDeadline;
+    unique_lock<mutex> lock(m_mutex);
+    while (true) {
+        auto hasWork = [this] { return m_stop || !m_tasks.empty(); };
+        if (bufferedRecords == 0) {
+            m_taskQueued.wait(lock, hasWork);
+        }
+        else {
+            m_taskQueued.wait_until(lock, flushDeadline, hasWork);
+        }
+        deque<Task> tasks;
+        tasks.swap(m_tasks);
+        bool stop = m_stop;
+        lock.unlock();
+
+        for (Task& task : tasks) {
+            bool wasEmpty = bufferedRecords == 0;
+            writeTask(task, bufferedRecords);
+            if (wasEmpty && bufferedRecords > 0) {
+                flushDeadline = chrono::steady_clock::now() + chrono::milliseconds(m_flushInterval.load());
+            }
+        }
+        if (bufferedRecords > 0 && (stop || bufferedRecords >= FlushMaxRecords || chrono::steady_clock::now() >= flushDeadline)) {
+            flushJournal(bufferedRecords);
+            // Changes that could not be written are retried after another interval
+            flushDeadline = chrono::steady_clock::now() + chrono::milliseconds(m_flushInterval.load());
+        }
+        if (!m_store.isOpen()) {
+            m_open = false;
+        }
+
+        lock.lock();
+        // close is called by the thread queuing the tasks, nothing is queued once m_stop is set
+        if (stop) {
+            return;
+        }
+    }
+}
+
+/**
+ * Write a task to the store, tasks are dropped once the store is closed after a failure
+ *
+ * @param task : Task to write
+ * @param bufferedRecords : Number of changes recorded and not flushed yet, updated
+ */
+void StateWriter::writeTask(Task& task, size_t& bufferedRecords) {
+    if (!m_store.isOpen()) {
+        return;
+    }
+    if (!task.isSnapshot) {
+        for (const auto& change : task.changes) {
+            m_store.record(task.config->getPivotId(change.first), change.second);
+        }
+        bufferedRecords += task.changes.size();
+        return;
+    }
+    if (!m_store.beginSnapshot()) {
+        return;
+    }
+    for (size_t pivotIndex = 0 ; pivotIndex < task.inputs.size() ; pivotIndex++) {
+        const PersistedInput& input = task.inputs[pivotIndex];
+        // Inputs never received have nothing to restore
+        if (input.state != 0 || input.quality != 0 || input.timestamp != 0) {
+            m_store.addSnapshotEntry(task.config->getPivotId(static_cast<int>(pivotIndex)), input);
+        }
+    }
+    // The snapshot holds every change recorded before it, they are dropped from the journal
+    if (m_store.commitSnapshot()) {
+        bufferedRecords = 0;
+    }
+}
+
+void StateWriter::flushJournal(size_t& bufferedRecords) {
+    if (m_store.flush()) {
+        bufferedRecords = 0;
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Running maximum of the timestamps of the inputs of the operations
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "timestampMaxima.h"
+
+#include <algorithm>
+
+/**
+ * Size the maxima for a number of operations, no timestamp being known
+ *
+ * @param operationCount : Number of compiled operations
+ */
+void TimestampMaxima::reset(std::size_t operationCount) {
+    m_maxima.assign(operationCount * GroupCount, 0);
+    m_stale.assign(operationCount * GroupCount, 0);
+}
+
+void TimestampMaxima::swap(TimestampMaxima& other) {
+    m_maxima.swap(other.m_maxima);
+    m_stale.swap(other.m_stale);
+}
+
+/**
+ * Take into account the timestamp of a new input of an operation
+ *
+ * @param operationIndex : Index of the compiled operation
+ * @param state : State of the input (PointState)
+ * @param timestamp : Packed timestamp of the input
+ */
+void TimestampMaxima::add(int operationIndex, int state, uint64_t timestamp) {
+    raise(slot(operationIndex, state), timestamp);
+    raise(slot(operationIndex, AllInputs), timestamp);
+}
+
+/**
+ * Take into account the change of state or timestamp of an input of an operation
+ *
+ * @param operationIndex : Index of the compiled operation
+ * @param oldState : Previous state of the input
+ * @param oldTimestamp : Previous timestamp of the input
+ * @param newState : New state of the input
+ * @param newTimestamp : New timestamp of the input
+ */
+void TimestampMaxima::move(int operationIndex, int oldState, uint64_t oldTimestamp, int newState, uint64_t newTimestamp) {
+    if (oldState != newState) {
+        lower(slot(operationIndex, oldState), oldTimestamp);
+    }
+    else if (newTimestamp < oldTimestamp) {
+        lower(slot(operationIndex, newState), oldTimestamp);
+    }
+    raise(slot(operationIndex, newState), newTimestamp);
+
+    if (newTimestamp < oldTimestamp) {
+        lower(slot(operationIndex, AllInputs), oldTimestamp);
+    }
+    raise(slot(operationIndex, AllInputs), newTimestamp);
+}
+
+/**
+ * Copy the maxima of an operation of another instance
+ *
+ * @param operationIndex : Index of the compiled operation in this instance
+ * @param other : Instance to copy from
+ * @param otherIndex : Index of the compiled operation in the other instance
+ */
+void TimestampMaxima::copyOperation(int operationIndex, const TimestampMaxima& other, int otherIndex) {
+    std::copy_n(other.m_maxima.begin() + slot(otherIndex, 0), GroupCount, m_maxima.begin() + slot(operationIndex, 0));
+    std::copy_n(other.m_stale.begin() + slot(otherIndex, 0), GroupCount, m_stale.begin() + slot(operationIndex, 0));
+}
+
+/**
+ * Store the maximum of a group recomputed from the inputs
+ *
+ * @param operationIndex : Index of the compiled operation
+ * @param group : State of the inputs or AllInputs
+ * @param timestamp : Newest timestamp of the inputs of the group
+ */
+void TimestampMaxima::setMaximum(int operationIndex, int group, uint64_t timestamp) {
+    m_maxima[slot(operationIndex, group)] = timestamp;
+    m_stale[slot(operationIndex, group)] = 0;
+}
+
+void TimestampMaxima::raise(std::size_t groupSlot, uint64_t timestamp) {
+    // A stale maximum is recomputed from all the inputs anyway
+    if (!m_stale[groupSlot] && timestamp > m_maxima[groupSlot]) {
+        m_maxima[groupSlot] = timestamp;
+    }
+}
+
+void TimestampMaxima::lower(std::size_t groupSlot, uint64_t timestamp) {
+    // Only the removal of the input holding the maximum can change it
+    if (timestamp >= m_maxima[groupSlot]) {
+        m_stale[groupSlot] = 1;
+    }
+}
@@ -10,6 +10,7 @@
  */
 #include "utilityOperation.h"
 
+#include <cstdio>
 #include <sstream>
 
 std::string UtilityOperation::join(const std::vector<std::string> &list, const std::string &sep /*= ", "*/) {
@@ -35,3 +36,28 @@ std::vector<std::string> UtilityOperation::split(const std::string& str, char se
     }
     return elems;
 }
+
+std::string UtilityOperation::escapeJson(const std::string& str) {
+    std::string ret;
+    ret.reserve(str.size());
+    for (char c : str) {
+        switch (c) {
+            case '"': ret += "\\\""; break;
+            case '\\': ret += "\\\\"; break;
+            case '\n': ret += "\\n"; break;
+            case '\r': ret += "\\r"; break;
+            case '\t': ret += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+                    ret += escaped;
+                }
+                else {
+                    ret += c;
+                }
+                break;
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,151 @@
+/*
+ * Pool of threads running the tasks of a parallel ingest
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "workerPool.h"
+
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * Start the threads of the pool
+ *
+ * @param workerCount : Number of workers, including the thread calling run (at least 1)
+ */
+WorkerPool::WorkerPool(size_t workerCount):
+    m_remainingTasks(0)
+{
+    workerCount = max<size_t>(workerCount, 1);
+    for (size_t i = 0 ; i < workerCount ; i++) {
+        m_queues.emplace_back(new TaskQueue);
+    }
+    // Worker 0 is the thread calling run
+    for (size_t i = 1 ; i < workerCount ; i++) {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> guard(m_mutex);
+        m_stop = true;
+    }
+    m_batchStarted.notify_all();
+    for (thread& workerThread : m_threads) {
+        workerThread.join();
+    }
+}
+
+/**
+ * Run a batch of tasks and wait until all of them are done
+ * Must not be called concurrently
+ *
+ * @param taskCount : Number of tasks, numbered from 0
+ * @param task : Function running a task
+ */
+void WorkerPool::run(size_t taskCount, const Task& task) {
+    if (taskCount == 0) {
+        return;
+    }
+    size_t workerCount = m_queues.size();
+    {
+        lock_guard<mutex> guard(m_mutex);
+        m_task = &task;
+        m_error = nullptr;
+        m_remainingTasks = taskCount;
+        for (size_t taskIndex = 0 ; taskIndex < taskCount ; taskIndex++) {
+            TaskQueue& queue = *m_queues[taskIndex % workerCount];
+            lock_guard<mutex> queueGuard(queue.mutex);
+            queue.tasks.push_back(taskIndex);
+        }
+        m_batch++;
+    }
+    m_batchStarted.notify_all();
+
+    runTasks(0);
+    unique_lock<mutex> lock(m_mutex);
+    m_batchDone.wait(lock, [this] { return m_remainingTasks == 0; });
+    m_task = nullptr;
+    if (m_error) {
+        rethrow_exception(m_error);
+    }
+}
+
+/**
+ * Main loop of the threads of the pool: run the tasks of each batch until the pool is destroyed
+ */
+void WorkerPool::workerLoop(size_t workerIndex) {
+    unsigned long lastBatch = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_batchStarted.wait(lock, [this, lastBatch] { return m_stop || m_batch != lastBatch; });
+            if (m_stop) {
+                return;
+            }
+            lastBatch = m_batch;
+        }
+        runTasks(workerIndex);
+    }
+}
+
+/**
+ * Run tasks until no queue has any left
+ *
+ * @param workerIndex : Index of the worker running the tasks
+ * @return true if at least one task was run, else false
+ */
+bool WorkerPool::runTasks(size_t workerIndex) {
+    bool ranTask = false;
+    size_t taskIndex = 0;
+    while (popTask(workerIndex, taskIndex)) {
+        ranTask = true;
+        try {
+            (*m_task)(taskIndex, workerIndex);
+        }
+        catch (...) {
+            lock_guard<mutex> guard(m_mutex);
+            if (!m_error) {
+                m_error = current_exception();
+            }
+        }
+        if (--m_remainingTasks == 0) {
+            lock_guard<mutex> guard(m_mutex);
+            m_batchDone.notify_all();
+        }
+    }
+    return ranTask;
+}
+
+/**
+ * Take the next task of a worker: the first one of its own queue, else the last one of another queue
+ *
+ * @param workerIndex : Index of the worker
+ * @param out_taskIndex : Out parameter storing the index of the task
+ * @return true if a task was found, else false
+ */
+bool WorkerPool::popTask(size_t workerIndex, size_t& out_taskIndex) {
+    size_t workerCount = m_queues.size();
+    for (size_t i = 0 ; i < workerCount ; i++) {
+        TaskQueue& queue = *m_queues[(workerIndex + i) % workerCount];
+        lock_guard<mutex> queueGuard(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            out_taskIndex = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        else {
+            out_taskIndex = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        return true;
+    }
+    return false;
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <logger.h>
 
 using namespace std;
  
@@ -9,6 +10,9 @@ int main(int argc, char **argv) {
     testing::GTEST_FLAG(shuffle) = true;
     testing::GTEST_FLAG(death_test_style) = "threadsafe";
 
+    // All messages are printed in stdout
+    Logger::getLogger()->setMinLevel("debug");
+
     return RUN_ALL_TESTS();
 }
 
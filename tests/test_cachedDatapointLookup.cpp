@@ -0,0 +1,58 @@
+#include "cachedDatapointLookup.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+static Datapoint *createIntegerDatapoint(const std::string& name, long value) {
+    DatapointValue dpv(value);
+    return new Datapoint(name, dpv);
+}
+
+static Datapoint *createDictDatapoint(const std::string& name) {
+    std::vector<Datapoint*> *children = new std::vector<Datapoint*>;
+    children->push_back(createIntegerDatapoint("child", 1));
+    DatapointValue dpv(children, true);
+    return new Datapoint(name, dpv);
+}
+
+TEST(CachedDatapointLookupTest, FindChildren)
+{
+    std::vector<Datapoint*> datapoints;
+    datapoints.push_back(createIntegerDatapoint("first", 1));
+    datapoints.push_back(createDictDatapoint("second"));
+    datapoints.push_back(createIntegerDatapoint("third", 3));
+    std::shared_ptr<void> cleaner(nullptr, [&datapoints](void*) {
+        for (Datapoint *dp : datapoints) {
+            delete dp;
+        }
+    });
+
+    CachedDatapointLookup lookupSecond("second");
+    CachedDatapointLookup lookupThird("third");
+    CachedDatapointLookup lookupMissing("missing");
+    ASSERT_STREQ(lookupSecond.getName().c_str(), "second");
+
+    ASSERT_EQ(lookupSecond.find(&datapoints), datapoints[1]);
+    ASSERT_EQ(lookupSecond.find(&datapoints), datapoints[1]);
+    ASSERT_NE(lookupSecond.findDict(&datapoints), nullptr);
+    ASSERT_EQ(lookupSecond.findDict(&datapoints)->size(), 1);
+    ASSERT_EQ(lookupThird.findValue(&datapoints)->toInt(), 3);
+    ASSERT_EQ(lookupThird.findDict(&datapoints), nullptr);
+    ASSERT_EQ(lookupMissing.find(&datapoints), nullptr);
+    ASSERT_EQ(lookupMissing.findValue(&datapoints), nullptr);
+    ASSERT_EQ(lookupMissing.find(nullptr), nullptr);
+
+    // Layout change: remembered positions are wrong and the lookup falls back to a scan
+    std::swap(datapoints[0], datapoints[2]);
+    ASSERT_EQ(lookupThird.findValue(&datapoints)->toInt(), 3);
+    ASSERT_EQ(lookupThird.find(&datapoints), datapoints[0]);
+    ASSERT_EQ(lookupSecond.find(&datapoints), datapoints[1]);
+    Datapoint *removed = datapoints.back();
+    datapoints.pop_back();
+    delete removed;
+    ASSERT_EQ(lookupSecond.find(&datapoints), datapoints[1]);
+    delete datapoints.front();
+    datapoints.erase(datapoints.begin());
+    ASSERT_EQ(lookupThird.find(&datapoints), nullptr);
+}
@@ -978,4 +978,431 @@ TEST_F(PluginConfigureTest, ConfigureErrorDuplicatePivotID)
     ASSERT_EQ(operationsLookupVec3.size(), 0);
     auto operationsLookupVec4 = filter->getConfigOperation().getOperationsForInputId("M_2367_3_15_5");
     ASSERT_EQ(operationsLookupVec4.size(), 0);
-}
\ No newline at end of file
+}
+TEST_F(PluginConfigureTest, ConfigureCompiledOperationGraph)
+{
+    static std::string configureCompiledGraph = QUOTE({
+        "exchanged_data": {
+            "datapoints" : [
+                {
+                    "label":"TS-1",
+                    "pivot_id" : "M_2367_3_15_4",
+                    "pivot_type" : "SpsTyp",
+                    "operations" : [
+                        {
+                            "operation": "or",
+                            "input" : [
+                                "M_2367_3_15_4",
+                                "M_2367_3_15_5"
+                            ]
+                        }
+                    ]
+                },
+                {
+                    "label":"TS-2",
+                    "pivot_id" : "M_2367_3_15_5",
+                    "pivot_type" : "DpsTyp",
+                    "operations" : [
+                        {
+                            "operation": "or",
+                            "input" : [
+                                "M_2367_3_15_4"
+                            ]
+                        },
+                        {
+                            "operation": "or",
+                            "input" : [
+                                "M_2367_3_15_6",
+                                "M_2367_3_15_4"
+                            ]
+                        }
+                    ]
+                }
+            ]
+        }
+    });
+
+    filter->setJsonConfig(configureCompiledGraph);
+    const ConfigOperation& config = filter->getConfigOperation();
+    ASSERT_EQ(config.getPivotCount(), 3);
+    ASSERT_EQ(config.getCompiledOutputCount(), 2);
+    ASSERT_EQ(config.getCompiledOperationCount(), 3);
+    int pivotIndex4 = config.getPivotIndex("M_2367_3_15_4");
+    int pivotIndex5 = config.getPivotIndex("M_2367_3_15_5");
+    int pivotIndex6 = config.getPivotIndex("M_2367_3_15_6");
+    ASSERT_GE(pivotIndex4, 0);
+    ASSERT_GE(pivotIndex5, 0);
+    ASSERT_GE(pivotIndex6, 0);
+    ASSERT_EQ(config.getPivotIndex("unknown"), -1);
+    ASSERT_STREQ(config.getPivotId(pivotIndex6).c_str(), "M_2367_3_15_6");
+
+    // Compiled lookups must follow the same order as getOperationsForInputId()
+    auto lookups4 = config.getCompiledOperationsForInput(pivotIndex4);
+    ASSERT_EQ(lookups4.size(), 3);
+    const CompiledLookup* lookup = lookups4.begin();
+    ASSERT_EQ(lookup[0].outputPivotIndex, pivotIndex4);
+    ASSERT_EQ(lookup[0].compiledOperationIndex, config.findCompiledOperation("M_2367_3_15_4", 0));
+    ASSERT_EQ(lookup[1].outputPivotIndex, pivotIndex5);
+    ASSERT_EQ(lookup[1].compiledOperationIndex, config.findCompiledOperation("M_2367_3_15_5", 0));
+    ASSERT_EQ(lookup[2].outputPivotIndex, pivotIndex5);
+    ASSERT_EQ(lookup[2].compiledOperationIndex, config.findCompiledOperation("M_2367_3_15_5", 1));
+    ASSERT_EQ(config.getCompiledOperationsForInput(pivotIndex6).size(), 1);
+    ASSERT_EQ(config.getCompiledOperationsForInput(-1).size(), 0);
+
+    int compiledOperationIndex = config.findCompiledOperation("M_2367_3_15_5", 1);
+    ASSERT_GE(compiledOperationIndex, 0);
+    const CompiledOperation& compiledOperation = config.getCompiledOperation(compiledOperationIndex);
+    ASSERT_EQ(compiledOperation.operationIndex, 1);
+    const CompiledOutput& compiledOutput = config.getCompiledOutput(compiledOperation.outputIndex);
+    ASSERT_EQ(compiledOutput.pivotIndex, pivotIndex5);
+    ASSERT_FALSE(compiledOutput.typeSps);
+    ASSERT_STREQ(compiledOutput.assetName.c_str(), "TS-2");
+    auto inputs = config.getOperationInputs(compiledOperation);
+    ASSERT_EQ(inputs.size(), 2);
+    ASSERT_EQ(inputs.begin()[0], pivotIndex6);
+    ASSERT_EQ(inputs.begin()[1], pivotIndex4);
+
+    ASSERT_EQ(config.findCompiledOperation("M_2367_3_15_5", 2), -1);
+    ASSERT_EQ(config.findCompiledOperation("M_2367_3_15_6", 0), -1);
+    ASSERT_EQ(config.findCompiledOperation("unknown", 0), -1);
+}
+
+TEST_F(PluginConfigureTest, ConfigureDifferential)
+{
+    static std::string configureInitial = QUOTE({
+        "exchanged_data": {
+            "datapoints" : [
+                {
+                    "label":"TS-4",
+                    "pivot_id" : "M_2367_3_15_4",
+                    "pivot_type" : "SpsTyp",
+                    "operations" : [
+                        {
+                            "operation": "or",
+                            "input" : [
+                                "M_2367_3_15_1",
+                                "M_2367_3_15_2"
+                            ]
+                        }
+                    ]
+                },
+                {
+                    "label":"TS-5",
+                    "pivot_id" : "M_2367_3_15_5",
+                    "pivot_type" : "DpsTyp",
+                    "operations" : [
+                        {
+                            "operation": "or",
+                            "input" : [
+                                "M_2367_3_15_1"
+                            ]
+                        }
+                    ]
+                },
+                {
+                    "label":"TS-6",
+                    "pivot_id" : "M_2367_3_15_6",
+                    "pivot_type" : "SpsTyp",
+                    "operations" : [
+                        {
+                            "operation": "or",
+                            "input" : [
+                                "M_2367_3_15_2"
+                            ]
+                        }
+                    ]
+                }
+            ]
+        }
+    });
+
+    static std::string configureUpdated = QUOTE({
+        "exchanged_data": {
+            "datapoints" : [
+                {
+                    "label":"TS-4",
+                    "pivot_id" : "M_2367_3_15_4",
+                    "pivot_type" : "SpsTyp",
+                    "operations" : [
+                        {
+                            "operation": "or",
+                            "input" : [
+                                "M_2367_3_15_1",
+                                "M_2367_3_15_2"
+                            ]
+                        }
+                    ]
+                },
+                {
+                    "label":"TS-5",
+                    "pivot_id" : "M_2367_3_15_5",
+                    "pivot_type" : "DpsTyp",
+                    "operations" : [
+                        {
+                            "operation": "or",
+                            "input" : [
+                                "M_2367_3_15_1",
+                                "M_2367_3_15_3"
+                            ]
+                        }
+                    ]
+                },
+                {
+                    "label":"TS-7",
+                    "pivot_id" : "M_2367_3_15_7",
+                    "pivot_type" : "SpsTyp",
+                    "operations" : [
+                        {
+                            "operation": "or",
+                            "input" : [
+                                "M_2367_3_15_3"
+                            ]
+                        }
+                    ]
+                }
+            ]
+        }
+    });
+
+    filter->setJsonConfig(configureInitial);
+    const ConfigOperation& initialConfig = filter->getConfigOperation();
+    unsigned long initialGeneration = initialConfig.getGeneration();
+    int initialOperation4 = initialConfig.findCompiledOperation("M_2367_3_15_4", 0);
+    ASSERT_GE(initialOperation4, 0);
+    int initialPivotIndex2 = initialConfig.getPivotIndex("M_2367_3_15_2");
+    ASSERT_GE(initialPivotIndex2, 0);
+    const CompiledOperation& initialCompiledOperation4 = initialConfig.getCompiledOperation(initialOperation4);
+    const OutputTemplate* template4 = initialConfig.getCompiledOutput(initialCompiledOperation4.outputIndex).readingTemplate.get();
+
+    filter->setJsonConfig(configureUpdated);
+    const ConfigOperation& config = filter->getConfigOperation();
+    ASSERT_EQ(config.getBaseGeneration(), initialGeneration);
+    ASSERT_EQ(config.getDiff().added, 1);
+    ASSERT_EQ(config.getDiff().removed, 1);
+    ASSERT_EQ(config.getDiff().modified, 1);
+    ASSERT_EQ(config.getDiff().unchanged, 1);
+
+    // Unchanged output keeps its compiled data, modified and added outputs are rebuilt
+    int operation4 = config.findCompiledOperation("M_2367_3_15_4", 0);
+    ASSERT_GE(operation4, 0);
+    ASSERT_EQ(config.getPreviousOperationIndex(operation4), initialOperation4);
+    const CompiledOperation& compiledOperation4 = config.getCompiledOperation(operation4);
+    ASSERT_EQ(config.getCompiledOutput(compiledOperation4.outputIndex).readingTemplate.get(), template4);
+    int operation5 = config.findCompiledOperation("M_2367_3_15_5", 0);
+    ASSERT_GE(operation5, 0);
+    ASSERT_EQ(config.getPreviousOperationIndex(operation5), -1);
+    int operation7 = config.findCompiledOperation("M_2367_3_15_7", 0);
+    ASSERT_GE(operation7, 0);
+    ASSERT_EQ(config.getPreviousOperationIndex(operation7), -1);
+    ASSERT_EQ(config.findCompiledOperation("M_2367_3_15_6", 0), -1);
+
+    // Pivot indexes of the previous configuration are mapped by pivot ID
+    ASSERT_EQ(config.getPreviousPivotIndex(config.getPivotIndex("M_2367_3_15_2")), initialPivotIndex2);
+    ASSERT_EQ(config.getPreviousPivotIndex(config.getPivotIndex("M_2367_3_15_3")), -1);
+}
+
+TEST_F(PluginConfigureTest, ConfigureOperators)
+{
+    static std::string configureOperators = QUOTE({
+        "exchanged_data": {
+            "datapoints" : [
+                {"label":"AND", "pivot_id":"M_10", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "and", "input": ["M_1", "M_2", "M_3"]}]},
+                {"label":"XOR", "pivot_id":"M_11", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "xor", "input": ["M_1", "M_2"]}]},
+                {"label":"NOT", "pivot_id":"M_12", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "not", "input": ["M_1"]}]},
+                {"label":"COUNT_GE", "pivot_id":"M_13", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "count_ge", "k": 2, "input": ["M_1", "M_2", "M_3"]}]},
+                {"label":"MAJORITY", "pivot_id":"M_14", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "majority", "input": ["M_1", "M_2", "M_3", "M_4"]}]},
+                {"label":"NOT_TWO_INPUTS", "pivot_id":"M_20", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "not", "input": ["M_1", "M_2"]}]},
+                {"label":"COUNT_GE_NO_K", "pivot_id":"M_21", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "count_ge", "input": ["M_1", "M_2"]}]},
+                {"label":"COUNT_GE_K_TOO_HIGH", "pivot_id":"M_22", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "count_ge", "k": 3, "input": ["M_1", "M_2"]}]},
+                {"label":"COUNT_GE_K_ZERO", "pivot_id":"M_23", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "count_ge", "k": 0, "input": ["M_1", "M_2"]}]},
+                {"label":"AND_NO_INPUT", "pivot_id":"M_24", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "and", "input": []}]},
+                {"label":"MAJORITY_NO_INPUT", "pivot_id":"M_25", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "majority", "input": []}]},
+                {"label":"XOR_NO_INPUT", "pivot_id":"M_26", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "xor", "input": []}]}
+            ]
+        }
+    });
+
+    filter->setJsonConfig(configureOperators);
+    const ConfigOperation& config = filter->getConfigOperation();
+    // Operations with invalid inputs or k are rejected, as "and" and "majority" without inputs which would be on.
+    // "or" and "xor" without inputs are off
+    ASSERT_EQ(config.getDataOperations().size(), 6);
+    ASSERT_EQ(config.getDataOperations().at("M_13").operations[0].threshold, 2);
+
+    // Every operation type is compiled to a kernel and its parameter
+    const std::map<std::string, std::pair<OperationKernel, uint32_t>> expectedKernels = {
+        {"M_10", {OperationKernel::Threshold, 3}},
+        {"M_11", {OperationKernel::Parity, 0}},
+        {"M_12", {OperationKernel::Parity, 1}},
+        {"M_13", {OperationKernel::Threshold, 2}},
+        {"M_14", {OperationKernel::Threshold, 3}},
+        {"M_26", {OperationKernel::Parity, 0}},
+    };
+    for (const auto& pivotIdAndKernel : expectedKernels) {
+        int compiledOperationIndex = config.findCompiledOperation(pivotIdAndKernel.first, 0);
+        ASSERT_GE(compiledOperationIndex, 0);
+        const CompiledOperation& compiledOperation = config.getCompiledOperation(compiledOperationIndex);
+        ASSERT_TRUE(compiledOperation.kernel == pivotIdAndKernel.second.first) << pivotIdAndKernel.first;
+        ASSERT_EQ(compiledOperation.kernelParameter, pivotIdAndKernel.second.second) << pivotIdAndKernel.first;
+    }
+}
+
+TEST_F(PluginConfigureTest, ConfigureExpressions)
+{
+    static std::string configureExpressions = QUOTE({
+        "exchanged_data": {
+            "datapoints" : [
+                {"label":"EXPR", "pivot_id":"M_10", "pivot_type":"SpsTyp",
+                 "operations": [{"expression": "(M_1 or M_2) and not M_3"}]},
+                {"label":"EXPR_COUNT", "pivot_id":"M_11", "pivot_type":"DpsTyp",
+                 "operations": [{"expression": "count(M_1, M_4) >= 1"}]},
+                {"label":"EXPR_INVALID", "pivot_id":"M_20", "pivot_type":"SpsTyp",
+                 "operations": [{"expression": "M_1 or"}]},
+                {"label":"EXPR_NOT_STRING", "pivot_id":"M_21", "pivot_type":"SpsTyp",
+                 "operations": [{"expression": 1}]},
+                {"label":"EXPR_WITH_INPUT", "pivot_id":"M_22", "pivot_type":"SpsTyp",
+                 "operations": [{"expression": "M_1", "input": ["M_1"]}]},
+                {"label":"EXPR_EMPTY", "pivot_id":"M_23", "pivot_type":"SpsTyp",
+                 "operations": [{"expression": ""}]}
+            ]
+        }
+    });
+
+    filter->setJsonConfig(configureExpressions);
+    const ConfigOperation& config = filter->getConfigOperation();
+    ASSERT_EQ(config.getDataOperations().size(), 2);
+    const OperationInfo& operationInfo = config.getDataOperations().at("M_10").operations[0];
+    ASSERT_EQ(operationInfo.operationType, "expression");
+    ASSERT_EQ(operationInfo.inputPivotIds, std::vector<std::string>({"M_1", "M_2", "M_3"}));
+
+    // The pivot IDs referenced by the expressions are its inputs in the lookup tables
+    ASSERT_EQ(config.getOperationsForInputId("M_1").size(), 2);
+    ASSERT_EQ(config.getOperationsForInputId("M_4").size(), 1);
+    int compiledOperationIndex = config.findCompiledOperation("M_11", 0);
+    ASSERT_GE(compiledOperationIndex, 0);
+    const CompiledOperation& compiledOperation = config.getCompiledOperation(compiledOperationIndex);
+    ASSERT_TRUE(compiledOperation.kernel == OperationKernel::Expression);
+    ASSERT_EQ(config.getOperationInputs(compiledOperation).size(), 2);
+    ASSERT_EQ(config.getExpressionCode(compiledOperation)->opcode, ExpressionInstruction::Input);
+}
+
+TEST_F(PluginConfigureTest, ConfigureChainedOperations)
+{
+    static std::string configureChainedOperations = QUOTE({
+        "exchanged_data": {
+            "datapoints" : [
+                {"label":"BAY-1", "pivot_id":"BAY_1", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "or", "input": ["IN_1", "IN_2"]}]},
+                {"label":"BAY-2", "pivot_id":"BAY_2", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "or", "input": ["IN_3", "BAY_2"]}]},
+                {"label":"LEVEL", "pivot_id":"LEVEL", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "and", "input": ["BAY_1", "BAY_2"]}]},
+                {"label":"SUBSTATION", "pivot_id":"SUBSTATION", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "or", "input": ["LEVEL", "BAY_1"]}]},
+                {"label":"CYCLE-A", "pivot_id":"CYCLE_A", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "or", "input": ["CYCLE_B", "IN_1"]}]},
+                {"label":"CYCLE-B", "pivot_id":"CYCLE_B", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "or", "input": ["CYCLE_A", "IN_2"]}]},
+                {"label":"AFTER-CYCLE", "pivot_id":"AFTER_CYCLE", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "or", "input": ["CYCLE_B"]}]},
+                {"label":"LAST", "pivot_id":"LAST", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "not", "input": ["AFTER_CYCLE"]}]}
+            ]
+        }
+    });
+
+    filter->setJsonConfig(configureChainedOperations);
+    const ConfigOperation& config = filter->getConfigOperation();
+    ASSERT_EQ(config.getDataOperations().size(), 8);
+    ASSERT_EQ(config.getChainLevelCount(), 3);
+
+    // Chained flag and chain level of each output: outputs of their own operations and outputs on a cycle are not chained
+    const std::map<std::string, std::pair<bool, int>> expectedChains = {
+        {"BAY_1", {true, 0}},
+        {"BAY_2", {false, 0}},
+        {"LEVEL", {true, 1}},
+        {"SUBSTATION", {false, 2}},
+        {"CYCLE_A", {false, 0}},
+        {"CYCLE_B", {false, 0}},
+        {"AFTER_CYCLE", {true, 0}},
+        {"LAST", {false, 1}},
+    };
+    for (const auto& pivotIdAndChain : expectedChains) {
+        int compiledOperationIndex = config.findCompiledOperation(pivotIdAndChain.first, 0);
+        ASSERT_GE(compiledOperationIndex, 0);
+        const CompiledOutput& compiledOutput = config.getCompiledOutput(config.getCompiledOperation(compiledOperationIndex).outputIndex);
+        ASSERT_EQ(compiledOutput.chained, pivotIdAndChain.second.first) << pivotIdAndChain.first;
+        ASSERT_EQ(compiledOutput.chainLevel, pivotIdAndChain.second.second) << pivotIdAndChain.first;
+        ASSERT_EQ(config.getChainLevel(compiledOperationIndex), pivotIdAndChain.second.second) << pivotIdAndChain.first;
+    }
+}
+
+
+TEST_F(PluginConfigureTest, ConfigureComponents)
+{
+    static std::string configureComponents = QUOTE({
+        "exchanged_data": {
+            "datapoints" : [
+                {"label":"OUT-1", "pivot_id":"OUT_1", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "or", "input": ["IN_1", "IN_2"]}]},
+                {"label":"OUT-2", "pivot_id":"OUT_2", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "and", "input": ["IN_3", "IN_4"]}]},
+                {"label":"OUT-3", "pivot_id":"OUT_3", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "or", "input": ["OUT_1", "IN_5"]}]},
+                {"label":"OUT-4", "pivot_id":"OUT_4", "pivot_type":"SpsTyp",
+                 "operations": [{"operation": "not", "input": ["IN_6"]},
+                                {"operation": "or", "input": ["IN_2", "IN_7"]}]},
+                {"label":"OUT-5", "pivot_id":"OUT_5", "pivot_type":"SpsTyp",
+                 "operations": [{"expression": "IN_8 and not IN_9"}]}
+            ]
+        }
+    });
+
+    filter->setJsonConfig(configureComponents);
+    const ConfigOperation& config = filter->getConfigOperation();
+    // Pivots are connected through the operations using them, whether as input or as output
+    const std::vector<std::vector<std::string>> expectedComponents = {
+        {"OUT_1", "IN_1", "IN_2", "OUT_3", "IN_5", "OUT_4", "IN_6", "IN_7"},
+        {"OUT_2", "IN_3", "IN_4"},
+        {"OUT_5", "IN_8", "IN_9"},
+    };
+    ASSERT_EQ(config.getComponentCount(), expectedComponents.size());
+    std::set<int> components;
+    for (const auto& pivotIds : expectedComponents) {
+        int component = config.getComponent(config.getPivotIndex(pivotIds[0]));
+        components.insert(component);
+        for (const auto& pivotId : pivotIds) {
+            ASSERT_EQ(config.getComponent(config.getPivotIndex(pivotId)), component) << pivotId;
+        }
+    }
+    ASSERT_EQ(components.size(), expectedComponents.size());
+}
+
+TEST_F(PluginConfigureTest, ConfigureTooManyInputs)
+{
+    // The inputs of an operation in each state are counted in the 21-bit fields of StateCounts
+    auto configureOr = [&](std::size_t inputCount) {
+        std::string inputs;
+        inputs.reserve(inputCount * 6);
+        for (std::size_t i = 0 ; i < inputCount ; i++) {
+            inputs += i > 0 ? ",\"M_1\"" : "\"M_1\"";
+        }
+        filter->setJsonConfig("{\"exchanged_data\": {\"datapoints\": [{\"label\":\"OR\", \"pivot_id\":\"M_10\", \"pivot_type\":\"SpsTyp\","
+                              " \"operations\": [{\"operation\": \"or\", \"input\": [" + inputs + "]}]}]}}");
+        return filter->getConfigOperation().getDataOperations().size();
+    };
+    ASSERT_EQ(configureOr(2), 1);
+    ASSERT_EQ(configureOr(StateCounts::FieldMask + 1), 0);
+}
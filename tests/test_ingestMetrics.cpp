@@ -0,0 +1,64 @@
+#include "ingestMetrics.h"
+
+#include <gtest/gtest.h>
+
+#include <datapoint.h>
+
+#include <memory>
+
+TEST(IngestMetricsTest, HistogramBuckets)
+{
+    // Small values are exact, larger ones are known within 1/16
+    for (uint64_t value = 0 ; value < LatencyHistogram::SubBucketCount ; value++) {
+        ASSERT_EQ(LatencyHistogram::getBucketIndex(value), value);
+        ASSERT_EQ(LatencyHistogram::getBucketUpperBound(value), value);
+    }
+    const uint64_t values[] = {16, 17, 31, 32, 33, 1000, 123456789, UINT64_MAX};
+    for (uint64_t value : values) {
+        std::size_t bucketIndex = LatencyHistogram::getBucketIndex(value);
+        ASSERT_LT(bucketIndex, LatencyHistogram::BucketCount) << value;
+        uint64_t upperBound = LatencyHistogram::getBucketUpperBound(bucketIndex);
+        ASSERT_GE(upperBound, value);
+        ASSERT_LE(upperBound - value, value / LatencyHistogram::SubBucketCount) << value;
+        ASSERT_EQ(LatencyHistogram::getBucketIndex(upperBound), bucketIndex) << value;
+        if (upperBound < UINT64_MAX) {
+            ASSERT_EQ(LatencyHistogram::getBucketIndex(upperBound + 1), bucketIndex + 1) << value;
+        }
+    }
+}
+
+TEST(IngestMetricsTest, HistogramPercentiles)
+{
+    LatencyHistogram histogram;
+    ASSERT_EQ(histogram.getValueAtPercentile(50.0), 0);
+    for (uint64_t value = 1 ; value <= 1000 ; value++) {
+        histogram.record(value * 1000);
+    }
+    ASSERT_EQ(histogram.getCount(), 1000);
+    ASSERT_EQ(histogram.getMax(), 1000000);
+    ASSERT_EQ(histogram.getMean(), 500500);
+    ASSERT_NEAR(histogram.getValueAtPercentile(50.0), 500000, 500000 / 16);
+    ASSERT_NEAR(histogram.getValueAtPercentile(99.0), 990000, 990000 / 16);
+    ASSERT_EQ(histogram.getValueAtPercentile(100.0), 1000000);
+}
+
+TEST(IngestMetricsTest, Counters)
+{
+    IngestMetrics metrics;
+    MetricCounts counts;
+    counts.add(MetricCounter::ReadingsMatched, 3);
+    counts.add(MetricCounter::IgnoredMissingCdc);
+    metrics.add(MetricCounter::ReadingsIn, 4);
+    metrics.add(counts);
+    metrics.add(counts);
+    ASSERT_EQ(metrics.get(MetricCounter::ReadingsIn), 4);
+    ASSERT_EQ(metrics.get(MetricCounter::ReadingsMatched), 3);
+    ASSERT_EQ(metrics.get(MetricCounter::IgnoredMissingCdc), 1);
+    ASSERT_EQ(metrics.get(MetricCounter::OutputsGenerated), 0);
+
+    std::unique_ptr<Datapoint> datapoint(metrics.toDatapoint("metrics"));
+    ASSERT_EQ(datapoint->getName(), "metrics");
+    ASSERT_EQ(datapoint->getData().getType(), DatapointValue::T_DP_DICT);
+    // One element per counter and per histogram
+    ASSERT_EQ(datapoint->getData().getDpVec()->size(), static_cast<std::size_t>(MetricCounter::Count) + 2);
+}
@@ -0,0 +1,55 @@
+#include "inputStateTable.h"
+
+#include <gtest/gtest.h>
+
+TEST(InputStateTableTest, UpdateValues)
+{
+    InputStateTable states;
+    states.reset(3);
+    ASSERT_EQ(states.size(), 3);
+    ASSERT_EQ(states.getValue(0), 0);
+    ASSERT_EQ(states.getValue(2), 0);
+
+    // Only changes are reported
+    ASSERT_TRUE(states.updateValue(1, 1));
+    ASSERT_FALSE(states.updateValue(1, 1));
+    ASSERT_EQ(states.getValue(1), 1);
+    ASSERT_TRUE(states.updateValue(1, 0));
+    ASSERT_EQ(states.getValue(1), 0);
+
+    // Flags stored next to the value are kept by updates
+    states.setState(2, 0x80);
+    ASSERT_TRUE(states.updateValue(2, 3));
+    ASSERT_EQ(states.getState(2), 0x83);
+    ASSERT_EQ(states.getValue(2), 3);
+
+    InputStateTable other;
+    other.reset(1);
+    states.swap(other);
+    ASSERT_EQ(states.size(), 1);
+    ASSERT_EQ(other.size(), 3);
+    ASSERT_EQ(other.getValue(2), 3);
+
+    // Qualities are stored next to the states and copied with them
+    other.setQuality(2, 0x0402);
+    ASSERT_EQ(other.getQuality(2), 0x0402);
+    ASSERT_EQ(other.getQuality(1), 0);
+    states.copyInput(0, other, 2);
+    ASSERT_EQ(states.getState(0), 0x83);
+    ASSERT_EQ(states.getQuality(0), 0x0402);
+
+    // Timestamps as well
+    other.setTimestamp(1, 0x1234000042);
+    ASSERT_EQ(other.getTimestamp(1), 0x1234000042);
+    ASSERT_EQ(other.getTimestamp(0), 0);
+    states.copyInput(0, other, 1);
+    ASSERT_EQ(states.getTimestamp(0), 0x1234000042);
+
+    // Inputs are unknown until set known, the flag is kept by value updates
+    ASSERT_FALSE(other.isKnown(0));
+    other.setKnown(0);
+    ASSERT_TRUE(other.isKnown(0));
+    ASSERT_TRUE(other.updateValue(0, 1));
+    ASSERT_TRUE(other.isKnown(0));
+    ASSERT_EQ(other.getValue(0), 1);
+}
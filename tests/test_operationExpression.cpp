@@ -0,0 +1,119 @@
+#include "operationExpression.h"
+#include "pointState.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+    /**
+     * Evaluate an expression with the given state of each of its inputs
+     */
+    int evaluateExpression(const std::string& expression, const std::vector<int>& values) {
+        std::vector<std::string> inputPivotIds;
+        std::vector<ExpressionInstruction> code;
+        std::string error;
+        EXPECT_TRUE(OperationExpression::parse(expression, inputPivotIds, code, error)) << error;
+        EXPECT_EQ(inputPivotIds.size(), values.size());
+        InputStateTable states;
+        states.reset(values.size());
+        std::vector<int> inputPivotIndexes;
+        for (std::size_t i = 0 ; i < values.size() ; i++) {
+            states.updateValue(static_cast<int>(i), values[i]);
+            inputPivotIndexes.push_back(static_cast<int>(i));
+        }
+        return OperationExpression::evaluate(code.data(), inputPivotIndexes.data(), states);
+    }
+}
+
+TEST(OperationExpressionTest, Parse)
+{
+    std::vector<std::string> inputPivotIds;
+    std::vector<ExpressionInstruction> code;
+    std::string error;
+
+    // Inputs are listed once, in order of first use
+    ASSERT_TRUE(OperationExpression::parse("(M_1 or M_2) and not M_1", inputPivotIds, code, error));
+    ASSERT_EQ(inputPivotIds, std::vector<std::string>({"M_1", "M_2"}));
+    ASSERT_EQ(code.size(), 7);
+    ASSERT_EQ(code[2].opcode, ExpressionInstruction::Or);
+    ASSERT_EQ(code[4].opcode, ExpressionInstruction::Not);
+    ASSERT_EQ(code[5].opcode, ExpressionInstruction::And);
+    ASSERT_EQ(code.back().opcode, ExpressionInstruction::Return);
+
+    // Comparisons of count are expressed with a threshold
+    ASSERT_TRUE(OperationExpression::parse("count(A, B, C) > 1", inputPivotIds, code, error));
+    ASSERT_EQ(inputPivotIds.size(), 3);
+    ASSERT_EQ(code[3].opcode, ExpressionInstruction::Count);
+    ASSERT_EQ(code[3].argumentCount, 3);
+    ASSERT_EQ(code[3].operand, 2);
+    ASSERT_EQ(code[3].comparison, ExpressionInstruction::GreaterOrEqual);
+    ASSERT_TRUE(OperationExpression::parse("count(A, B) <= 1", inputPivotIds, code, error));
+    ASSERT_EQ(code[2].operand, 2);
+    ASSERT_EQ(code[2].comparison, ExpressionInstruction::Less);
+
+    // Keywords are only recognized as whole words
+    ASSERT_TRUE(OperationExpression::parse("notA or order", inputPivotIds, code, error));
+    ASSERT_EQ(inputPivotIds, std::vector<std::string>({"notA", "order"}));
+
+    const std::vector<std::string> invalidExpressions = {
+        "", "A and", "and A", "(A or B", "A B", "A or B)", "count(A, B)", "count(A, B) >= x",
+        "count(A, B) >= -1", "count() >= 1", "A & B",
+    };
+    for (const auto& expression : invalidExpressions) {
+        ASSERT_FALSE(OperationExpression::parse(expression, inputPivotIds, code, error)) << expression;
+        ASSERT_FALSE(error.empty()) << expression;
+    }
+
+    // The evaluation stack is bounded
+    std::string deepExpression = "A";
+    for (int i = 0 ; i < OperationExpression::MaxStackDepth ; i++) {
+        deepExpression = "A or (" + deepExpression + ")";
+    }
+    ASSERT_FALSE(OperationExpression::parse(deepExpression, inputPivotIds, code, error));
+
+    // So is the nesting of the parser, whatever the size of the stack
+    ASSERT_FALSE(OperationExpression::parse(std::string(1000000, '(') + "A" + std::string(1000000, ')'), inputPivotIds, code, error));
+    ASSERT_EQ(error.find("expression too deep"), 0) << error;
+    std::string nestedExpression = "A";
+    for (int i = 1 ; i < OperationExpression::MaxNestingDepth ; i++) {
+        nestedExpression = "(" + nestedExpression + ")";
+    }
+    ASSERT_TRUE(OperationExpression::parse(nestedExpression, inputPivotIds, code, error)) << error;
+    ASSERT_FALSE(OperationExpression::parse("(" + nestedExpression + ")", inputPivotIds, code, error));
+    std::string notExpression;
+    for (int i = 0 ; i < 100000 ; i++) {
+        notExpression += "not ";
+    }
+    ASSERT_TRUE(OperationExpression::parse(notExpression + "A", inputPivotIds, code, error)) << error;
+}
+
+TEST(OperationExpressionTest, Evaluate)
+{
+    const int off = PointState::StateOff;
+    const int on = PointState::StateOn;
+    const int inter = PointState::StateIntermediate;
+    const int bad = PointState::StateBad;
+
+    ASSERT_EQ(evaluateExpression("(A or B) and not C", {on, off, off}), on);
+    ASSERT_EQ(evaluateExpression("(A or B) and not C", {on, off, on}), off);
+    ASSERT_EQ(evaluateExpression("A or B and C", {on, off, off}), on);
+    ASSERT_EQ(evaluateExpression("A xor B", {on, on}), off);
+    ASSERT_EQ(evaluateExpression("not not A", {on}), on);
+
+    // Intermediate and bad inputs follow the rules of the operation types
+    ASSERT_EQ(evaluateExpression("A or B", {inter, on}), on);
+    ASSERT_EQ(evaluateExpression("A or B", {inter, bad}), bad);
+    ASSERT_EQ(evaluateExpression("A and B", {inter, off}), off);
+    ASSERT_EQ(evaluateExpression("A and B", {inter, bad}), inter);
+    ASSERT_EQ(evaluateExpression("not A", {bad}), bad);
+    ASSERT_EQ(evaluateExpression("A xor B", {inter, on}), inter);
+
+    ASSERT_EQ(evaluateExpression("count(A, B, C, D) >= 2", {on, off, on, off}), on);
+    ASSERT_EQ(evaluateExpression("count(A, B, C, D) >= 2", {on, off, bad, off}), bad);
+    ASSERT_EQ(evaluateExpression("count(A, B, C, D) < 2", {on, off, off, off}), on);
+    ASSERT_EQ(evaluateExpression("count(A, B, C) == 1", {on, off, off}), on);
+    ASSERT_EQ(evaluateExpression("count(A, B, C) == 1", {on, on, off}), off);
+    ASSERT_EQ(evaluateExpression("count(A, B, C) == 1", {on, inter, off}), inter);
+    ASSERT_EQ(evaluateExpression("count(A, B, C) != 1", {off, off, off}), on);
+    ASSERT_EQ(evaluateExpression("count(A and B, not C) >= 2", {on, on, off}), on);
+    ASSERT_EQ(evaluateExpression("count(A, A, B) >= 2", {on, off}), on);
+}
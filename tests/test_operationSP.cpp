@@ -3,9 +3,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <regex>
 #include <queue>
 
+#include <unistd.h>
+
 
 using namespace rapidjson;
 
@@ -147,6 +151,21 @@ static void createReadingSet(ReadingSet*& outReadingSet, const std::string& asse
     createReadingSet(outReadingSet, assetName, std::vector<std::string>{json});
 }
 
+static void createReadingSetMultipleReadings(ReadingSet*& outReadingSet, const std::vector<std::pair<std::string, std::string>>& assetsAndJsons)
+{
+    std::vector<Reading*> *readings = new std::vector<Reading*>();
+    for(const auto& assetAndJson: assetsAndJsons) {
+        // Create Reading
+        std::vector<Datapoint*> *p = nullptr;
+        ASSERT_NO_THROW(p = dummyDataPoint.parseJson(assetAndJson.second));
+        ASSERT_NE(p, nullptr);
+        readings->push_back(new Reading(assetAndJson.first, *p));
+        delete p;
+    }
+    // Create ReadingSet
+    outReadingSet = new ReadingSet(readings);
+}
+
 static void createEmptyReadingSet(ReadingSet*& outReadingSet, const std::string& assetName)
 {
     std::vector<Datapoint*> *allPoints = new std::vector<Datapoint*>();
@@ -1235,4 +1254,1296 @@ TEST_F(PluginIngestTest, InvalidMessages)
     ASSERT_EQ(readings.size(), 1);
     ASSERT_NO_THROW(currentReading.reset(filter->generateReadingOperation(readings[0], "M_2367_3_15_5", 0)));
     ASSERT_EQ(currentReading.get(), nullptr);
-}
\ No newline at end of file
+}
+TEST_F(PluginIngestTest, RepeatedValuesOperationOU)
+{
+    std::string jsonMessageTS1_1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+    std::string jsonMessageTS1_0 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "0", "1669714181", "9529451");
+    std::string jsonMessageTS1_2 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "2", "1669714181", "9529451");
+
+    // Sending the same value several times must not be counted several times by the operation
+    for (const std::string& json: {jsonMessageTS1_1, jsonMessageTS1_1, jsonMessageTS1_2, jsonMessageTS1_0}) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, "TS-1", json);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        if(HasFatalFailure()) return;
+        ASSERT_NE(readingSet, nullptr);
+        ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+        ASSERT_EQ(resultReading->getAllReadings().size(), 3);
+    }
+    ASSERT_EQ(outputHandlerCalled, 4);
+
+    const std::vector<std::string> expectedValues = {"1", "1", "1", "0"};
+    for (const std::string& expectedValue: expectedValues) {
+        std::shared_ptr<Reading> currentReading = popFrontReading();
+        ASSERT_NE(currentReading.get(), nullptr);
+        ASSERT_EQ(currentReading->getAssetName(), "TS-1");
+        currentReading = popFrontReading();
+        validateReading(currentReading, "TS-2", "PIVOT", allPivotAttributeNames, {
+            {"GTIS.Identifier", {"string", "M_2367_3_15_5"}},
+            {"GTIS.DpsTyp.stVal", {"string", expectedValue == "1" ? "on" : "off"}},
+            {"GTIS.DpsTyp.q.Validity", {"string", "good"}},
+            {"GTIS.DpsTyp.q.Source", {"string", "substituted"}},
+            {"GTIS.DpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714181"}},
+            {"GTIS.DpsTyp.t.FractionOfSecond", {"int64_t", "9529451"}},
+        });
+        if(HasFatalFailure()) return;
+        currentReading = popFrontReading();
+        validateReading(currentReading, "TS-3", "PIVOT", allPivotAttributeNames, {
+            {"GTIS.Identifier", {"string", "M_2367_3_15_6"}},
+            {"GTIS.SpsTyp.stVal", {"int64_t", expectedValue}},
+            {"GTIS.SpsTyp.q.Validity", {"string", "good"}},
+            {"GTIS.SpsTyp.q.Source", {"string", "substituted"}},
+            {"GTIS.SpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714181"}},
+            {"GTIS.SpsTyp.t.FractionOfSecond", {"int64_t", "9529451"}},
+        });
+        if(HasFatalFailure()) return;
+    }
+}
+
+TEST_F(PluginIngestTest, OutputKeepsInputAttributes)
+{
+    std::string jsonMessageTS1 = QUOTE({
+        "PIVOT": {
+            "GTIS": {
+                "ComingFrom": "iec104",
+                "Cause": {
+                    "stVal": 3
+                },
+                "TmOrg": {
+                    "stVal": "genuine"
+                },
+                "SpsTyp": {
+                    "q": {
+                        "DetailQuality": {
+                            "oldData": 1
+                        },
+                        "Source": "process",
+                        "Validity": "questionable"
+                    },
+                    "t": {
+                        "FractionOfSecond": 9529451,
+                        "SecondSinceEpoch": 1669714181
+                    },
+                    "stVal": 1
+                },
+                "Identifier": "M_2367_3_15_4"
+            }
+        }
+    });
+
+    ReadingSet* readingSet = nullptr;
+    createReadingSet(readingSet, "TS-1", jsonMessageTS1);
+    std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+    if(HasFatalFailure()) return;
+    ASSERT_NE(readingSet, nullptr);
+
+    ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+    ASSERT_EQ(outputHandlerCalled, 1);
+    ASSERT_EQ(resultReading->getAllReadings().size(), 3);
+    std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-2");
+    validateReading(currentReading, "TS-2", "PIVOT", allPivotAttributeNames, {
+        {"GTIS.ComingFrom", {"string", "iec104"}},
+        {"GTIS.Cause.stVal", {"int64_t", "3"}},
+        {"GTIS.TmOrg.stVal", {"string", "genuine"}},
+        {"GTIS.Identifier", {"string", "M_2367_3_15_5"}},
+        {"GTIS.DpsTyp.stVal", {"string", "on"}},
+        {"GTIS.DpsTyp.q.Validity", {"string", "questionable"}},
+        {"GTIS.DpsTyp.q.Source", {"string", "substituted"}},
+        {"GTIS.DpsTyp.q.DetailQuality.oldData", {"int64_t", "1"}},
+        {"GTIS.DpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714181"}},
+        {"GTIS.DpsTyp.t.FractionOfSecond", {"int64_t", "9529451"}},
+    });
+    if(HasFatalFailure()) return;
+    currentReading = popFrontReading();
+    validateReading(currentReading, "TS-3", "PIVOT", allPivotAttributeNames, {
+        {"GTIS.ComingFrom", {"string", "iec104"}},
+        {"GTIS.Cause.stVal", {"int64_t", "3"}},
+        {"GTIS.TmOrg.stVal", {"string", "genuine"}},
+        {"GTIS.Identifier", {"string", "M_2367_3_15_6"}},
+        {"GTIS.SpsTyp.stVal", {"int64_t", "1"}},
+        {"GTIS.SpsTyp.q.Validity", {"string", "questionable"}},
+        {"GTIS.SpsTyp.q.Source", {"string", "substituted"}},
+        {"GTIS.SpsTyp.q.DetailQuality.oldData", {"int64_t", "1"}},
+        {"GTIS.SpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714181"}},
+        {"GTIS.SpsTyp.t.FractionOfSecond", {"int64_t", "9529451"}},
+    });
+    if(HasFatalFailure()) return;
+}
+
+TEST_F(PluginIngestTest, CachedValuesKeptOnReconfigure)
+{
+    static std::string reconfigure = QUOTE({
+        "enable" :{
+            "value": "true"
+        },
+        "exchanged_data": {
+            "value" : {
+                "exchanged_data": {
+                    "name" : "SAMPLE",
+                    "version" : "1.0",
+                    "datapoints" : [
+                        {
+                            "label":"TS-1",
+                            "pivot_id":"M_2367_3_15_4",
+                            "pivot_type":"SpsTyp"
+                        },
+                        {
+                            "label":"TS-3",
+                            "pivot_id":"M_2367_3_15_6",
+                            "pivot_type":"SpsTyp",
+                            "operations": [
+                                {
+                                    "operation": "or",
+                                    "input": [
+                                        "M_2367_3_15_4",
+                                        "M_2367_3_15_7"
+                                    ]
+                                }
+                            ]
+                        },
+                        {
+                            "label":"TS-4",
+                            "pivot_id":"M_2367_3_15_7",
+                            "pivot_type":"SpsTyp"
+                        }
+                    ]
+                }
+            }
+        }
+    });
+
+    std::string jsonMessageTS1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+    ReadingSet* readingSet = nullptr;
+    createReadingSet(readingSet, "TS-1", jsonMessageTS1);
+    std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+    if(HasFatalFailure()) return;
+    ASSERT_NE(readingSet, nullptr);
+    ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+    ASSERT_EQ(outputHandlerCalled, 1);
+    storedReadings = {};
+
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+    ASSERT_EQ(filter->getConfigOperation().getDataOperations().size(), 1);
+
+    // TS-1 value received before the reconfiguration is still taken into account
+    std::string jsonMessageTS4 = generatePivotTS("SpsTyp", "M_2367_3_15_7", "0", "1669714182", "9529452");
+    ReadingSet* readingSet2 = nullptr;
+    createReadingSet(readingSet2, "TS-4", jsonMessageTS4);
+    std::shared_ptr<ReadingSet> readingSetCleaner2(readingSet2);
+    if(HasFatalFailure()) return;
+    ASSERT_NE(readingSet2, nullptr);
+    ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet2)));
+    ASSERT_EQ(outputHandlerCalled, 2);
+    ASSERT_EQ(resultReading->getAllReadings().size(), 2);
+
+    std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-3");
+    validateReading(currentReading, "TS-3", "PIVOT", allPivotAttributeNames, {
+        {"GTIS.Identifier", {"string", "M_2367_3_15_6"}},
+        {"GTIS.SpsTyp.stVal", {"int64_t", "1"}},
+        {"GTIS.SpsTyp.q.Validity", {"string", "good"}},
+        {"GTIS.SpsTyp.q.Source", {"string", "substituted"}},
+        {"GTIS.SpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714182"}},
+        {"GTIS.SpsTyp.t.FractionOfSecond", {"int64_t", "9529452"}},
+    });
+    if(HasFatalFailure()) return;
+}
+
+TEST_F(PluginIngestTest, MultipleReadingsOrderKept)
+{
+    std::string jsonMessageTS1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+    std::string jsonMessageTS2 = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"off\"", "1669714182", "9529452");
+    std::string jsonMessageOther1 = generatePivotTS("SpsTyp", "M_2367_3_15_10", "1", "1669714183", "9529453");
+    std::string jsonMessageOther2 = generatePivotTS("SpsTyp", "M_2367_3_15_11", "0", "1669714184", "9529454");
+
+    ReadingSet* readingSet = nullptr;
+    createReadingSetMultipleReadings(readingSet, {
+        {"TS-1", jsonMessageTS1},
+        {"OTHER-1", jsonMessageOther1},
+        {"TS-2", jsonMessageTS2},
+        {"OTHER-2", jsonMessageOther2},
+    });
+    std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+    if(HasFatalFailure()) return;
+    ASSERT_NE(readingSet, nullptr);
+    ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+    ASSERT_EQ(outputHandlerCalled, 1);
+
+    // Input TS-2 is rewritten in place with its computed value, inputs keep their order and generated readings follow
+    const std::vector<std::string> expectedAssets = {"TS-1", "OTHER-1", "TS-2", "OTHER-2", "TS-2", "TS-3", "TS-3"};
+    ASSERT_EQ(resultReading->getAllReadings().size(), expectedAssets.size());
+    for (std::size_t i = 0 ; i < expectedAssets.size() ; i++) {
+        std::shared_ptr<Reading> currentReading = popFrontReading();
+        ASSERT_NE(currentReading.get(), nullptr);
+        ASSERT_EQ(currentReading->getAssetName(), expectedAssets[i]);
+        if (i == 2) {
+            validateReading(currentReading, "TS-2", "PIVOT", allPivotAttributeNames, {
+                {"GTIS.Identifier", {"string", "M_2367_3_15_5"}},
+                {"GTIS.DpsTyp.stVal", {"string", "on"}},
+                {"GTIS.DpsTyp.q.Validity", {"string", "good"}},
+                {"GTIS.DpsTyp.q.Source", {"string", "substituted"}},
+                {"GTIS.DpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714182"}},
+                {"GTIS.DpsTyp.t.FractionOfSecond", {"int64_t", "9529452"}},
+            });
+            if(HasFatalFailure()) return;
+        }
+    }
+}
+
+TEST_F(PluginIngestTest, EmitPolicyOnChange)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "emit_policy": {
+            "value": "on-change"
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+
+    std::string jsonMessageTS1_1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+    std::string jsonMessageTS2_0 = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"off\"", "1669714182", "9529452");
+    std::string jsonMessageTS1_0 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "0", "1669714183", "9529453");
+
+    // Outputs are only generated when their value changes, TS-2 input is removed when its output did not change
+    const std::vector<std::pair<std::string, std::string>> inputs = {
+        {"TS-1", jsonMessageTS1_1}, {"TS-1", jsonMessageTS1_1}, {"TS-2", jsonMessageTS2_0}, {"TS-1", jsonMessageTS1_0}};
+    const std::vector<std::vector<std::string>> expectedAssets = {
+        {"TS-1", "TS-2", "TS-3"}, {"TS-1"}, {}, {"TS-1", "TS-2", "TS-3"}};
+    for (std::size_t i = 0 ; i < inputs.size() ; i++) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, inputs[i].first, inputs[i].second);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        if(HasFatalFailure()) return;
+        ASSERT_NE(readingSet, nullptr);
+        ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+        ASSERT_EQ(resultReading->getAllReadings().size(), expectedAssets[i].size());
+        for (const std::string& expectedAsset: expectedAssets[i]) {
+            std::shared_ptr<Reading> currentReading = popFrontReading();
+            ASSERT_NE(currentReading.get(), nullptr);
+            ASSERT_EQ(currentReading->getAssetName(), expectedAsset);
+        }
+    }
+    ASSERT_EQ(outputHandlerCalled, 4);
+}
+
+TEST_F(PluginIngestTest, EmitPolicyOnChangeOrQualityChange)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "emit_policy": {
+            "value": "on-change-or-quality-change"
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+
+    std::string jsonMessageTS1_good = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+    std::string jsonMessageTS1_questionable = std::regex_replace(jsonMessageTS1_good, std::regex("good"), "questionable");
+
+    // Same value with the same quality is filtered out, a quality change is forwarded
+    const std::vector<std::string> inputs = {jsonMessageTS1_good, jsonMessageTS1_good, jsonMessageTS1_questionable};
+    const std::vector<std::size_t> expectedCounts = {3, 1, 3};
+    for (std::size_t i = 0 ; i < inputs.size() ; i++) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, "TS-1", inputs[i]);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        if(HasFatalFailure()) return;
+        ASSERT_NE(readingSet, nullptr);
+        ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+        ASSERT_EQ(resultReading->getAllReadings().size(), expectedCounts[i]);
+    }
+
+    std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-1");
+    currentReading = popFrontReadingsUntil("TS-1");
+    currentReading = popFrontReadingsUntil("TS-1");
+    currentReading = popFrontReading();
+    validateReading(currentReading, "TS-2", "PIVOT", allPivotAttributeNames, {
+        {"GTIS.Identifier", {"string", "M_2367_3_15_5"}},
+        {"GTIS.DpsTyp.stVal", {"string", "on"}},
+        {"GTIS.DpsTyp.q.Validity", {"string", "questionable"}},
+        {"GTIS.DpsTyp.q.Source", {"string", "substituted"}},
+        {"GTIS.DpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714181"}},
+        {"GTIS.DpsTyp.t.FractionOfSecond", {"int64_t", "9529451"}},
+    });
+    if(HasFatalFailure()) return;
+}
+
+TEST_F(PluginIngestTest, InputRewrittenInPlace)
+{
+    // TS-2 received as a SPS under another asset name is rewritten with the type and asset name of the output
+    std::string jsonMessageTS2 = generatePivotTS("SpsTyp", "M_2367_3_15_5", "1", "1669714181", "9529451");
+    std::string jsonMessageOther = generatePivotTS("SpsTyp", "M_2367_3_15_10", "1", "1669714183", "9529453");
+
+    ReadingSet* readingSet = nullptr;
+    createReadingSetMultipleReadings(readingSet, {
+        {"TS-2-RAW", jsonMessageTS2},
+        {"OTHER-1", jsonMessageOther},
+    });
+    std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+    if(HasFatalFailure()) return;
+    ASSERT_NE(readingSet, nullptr);
+    ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+    ASSERT_EQ(outputHandlerCalled, 1);
+    ASSERT_EQ(resultReading->getAllReadings().size(), 3);
+
+    std::shared_ptr<Reading> currentReading = popFrontReading();
+    validateReading(currentReading, "TS-2", "PIVOT", allPivotAttributeNames, {
+        {"GTIS.Identifier", {"string", "M_2367_3_15_5"}},
+        {"GTIS.DpsTyp.stVal", {"string", "on"}},
+        {"GTIS.DpsTyp.q.Validity", {"string", "good"}},
+        {"GTIS.DpsTyp.q.Source", {"string", "substituted"}},
+        {"GTIS.DpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714181"}},
+        {"GTIS.DpsTyp.t.FractionOfSecond", {"int64_t", "9529451"}},
+    });
+    if(HasFatalFailure()) return;
+    currentReading = popFrontReading();
+    ASSERT_NE(currentReading.get(), nullptr);
+    ASSERT_EQ(currentReading->getAssetName(), "OTHER-1");
+    currentReading = popFrontReading();
+    validateReading(currentReading, "TS-3", "PIVOT", allPivotAttributeNames, {
+        {"GTIS.Identifier", {"string", "M_2367_3_15_6"}},
+        {"GTIS.SpsTyp.stVal", {"int64_t", "1"}},
+        {"GTIS.SpsTyp.q.Validity", {"string", "good"}},
+        {"GTIS.SpsTyp.q.Source", {"string", "substituted"}},
+        {"GTIS.SpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714181"}},
+        {"GTIS.SpsTyp.t.FractionOfSecond", {"int64_t", "9529451"}},
+    });
+    if(HasFatalFailure()) return;
+}
+
+TEST_F(PluginIngestTest, CoalesceOutputs)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "coalesce_outputs": {
+            "value": "true"
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+
+    std::string jsonMessageTS1_1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+    std::string jsonMessageTS2_0 = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"off\"", "1669714183", "9529453");
+    std::string jsonMessageTS1_0 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "0", "1669714182", "9529452");
+
+    ReadingSet* readingSet = nullptr;
+    createReadingSetMultipleReadings(readingSet, {
+        {"TS-1", jsonMessageTS1_1},
+        {"TS-2", jsonMessageTS2_0},
+        {"TS-1", jsonMessageTS1_0},
+    });
+    std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+    if(HasFatalFailure()) return;
+    ASSERT_NE(readingSet, nullptr);
+    ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+    ASSERT_EQ(outputHandlerCalled, 1);
+
+    // One reading per output with the final value, built from the input with the newest timestamp
+    ASSERT_EQ(resultReading->getAllReadings().size(), 4);
+    std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-1");
+    currentReading = popFrontReadingsUntil("TS-1");
+    ASSERT_NE(currentReading.get(), nullptr);
+    currentReading = popFrontReading();
+    validateReading(currentReading, "TS-2", "PIVOT", allPivotAttributeNames, {
+        {"GTIS.Identifier", {"string", "M_2367_3_15_5"}},
+        {"GTIS.DpsTyp.stVal", {"string", "off"}},
+        {"GTIS.DpsTyp.q.Validity", {"string", "good"}},
+        {"GTIS.DpsTyp.q.Source", {"string", "substituted"}},
+        {"GTIS.DpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714183"}},
+        {"GTIS.DpsTyp.t.FractionOfSecond", {"int64_t", "9529453"}},
+    });
+    if(HasFatalFailure()) return;
+    currentReading = popFrontReading();
+    validateReading(currentReading, "TS-3", "PIVOT", allPivotAttributeNames, {
+        {"GTIS.Identifier", {"string", "M_2367_3_15_6"}},
+        {"GTIS.SpsTyp.stVal", {"int64_t", "0"}},
+        {"GTIS.SpsTyp.q.Validity", {"string", "good"}},
+        {"GTIS.SpsTyp.q.Source", {"string", "substituted"}},
+        {"GTIS.SpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714183"}},
+        {"GTIS.SpsTyp.t.FractionOfSecond", {"int64_t", "9529453"}},
+    });
+    if(HasFatalFailure()) return;
+}
+
+TEST_F(PluginIngestTest, DpsFourStates)
+{
+    std::string jsonMessageTS2_intermediate = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"intermediate-state\"", "1669714181", "9529451");
+    std::string jsonMessageTS2_bad = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"bad-state\"", "1669714181", "9529451");
+    std::string jsonMessageTS1_1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+
+    // Without any input on, the "or" takes the worst state of its inputs, SPS outputs stay off
+    const std::vector<std::pair<std::string, std::string>> inputs = {
+        {"TS-2", jsonMessageTS2_intermediate}, {"TS-2", jsonMessageTS2_bad}, {"TS-1", jsonMessageTS1_1}};
+    const std::vector<std::pair<std::string, std::string>> expectedValues = {
+        {"intermediate-state", "0"}, {"bad-state", "0"}, {"on", "1"}};
+    for (std::size_t i = 0 ; i < inputs.size() ; i++) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, inputs[i].first, inputs[i].second);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        if(HasFatalFailure()) return;
+        ASSERT_NE(readingSet, nullptr);
+        ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+
+        std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-2");
+        validateReading(currentReading, "TS-2", "PIVOT", allPivotAttributeNames, {
+            {"GTIS.Identifier", {"string", "M_2367_3_15_5"}},
+            {"GTIS.DpsTyp.stVal", {"string", expectedValues[i].first}},
+            {"GTIS.DpsTyp.q.Validity", {"string", "good"}},
+            {"GTIS.DpsTyp.q.Source", {"string", "substituted"}},
+            {"GTIS.DpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714181"}},
+            {"GTIS.DpsTyp.t.FractionOfSecond", {"int64_t", "9529451"}},
+        });
+        if(HasFatalFailure()) return;
+        currentReading = popFrontReadingsUntil("TS-3");
+        ASSERT_NE(currentReading.get(), nullptr);
+        std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+        ASSERT_EQ(getIntValue(*callOnLastPathElement(*getObject(*currentReading, "PIVOT"), "GTIS.SpsTyp.stVal", getChildFn)),
+                  std::stoll(expectedValues[i].second));
+        storedReadings = {};
+    }
+}
+
+TEST_F(PluginIngestTest, QualityPolicies)
+{
+    std::string jsonMessageTS2_on = std::regex_replace(generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"on\"", "1669714181", "9529451"),
+                                                       std::regex("\"Validity\""), "\"DetailQuality\":{\"oldData\":1},\"Validity\"");
+    jsonMessageTS2_on = std::regex_replace(jsonMessageTS2_on, std::regex("good"), "questionable");
+    std::string jsonMessageTS1_on = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714182", "9529452");
+    std::string jsonMessageTS2_off = std::regex_replace(generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"off\"", "1669714183", "9529453"),
+                                                        std::regex("good"), "questionable");
+
+    // Quality of TS-3 after each input, for each policy: {Validity, oldData (empty if absent)}
+    const std::vector<std::pair<std::string, std::string>> inputs = {
+        {"TS-2", jsonMessageTS2_on}, {"TS-1", jsonMessageTS1_on}, {"TS-2", jsonMessageTS2_off}};
+    const std::map<std::string, std::vector<std::pair<std::string, std::string>>> expectedQualities = {
+        {"trigger", {{"questionable", "1"}, {"good", ""}, {"questionable", ""}}},
+        {"worst_of", {{"questionable", "1"}, {"questionable", "1"}, {"questionable", ""}}},
+        {"contributing", {{"questionable", "1"}, {"questionable", "1"}, {"good", ""}}},
+    };
+    for (const auto& policyAndQualities : expectedQualities) {
+        std::string reconfigure = QUOTE({
+            "enable": {
+                "value": "true"
+            },
+            "quality_policy": {
+                "value": "<policy>"
+            }
+        });
+        reconfigure = std::regex_replace(reconfigure, std::regex("<policy>"), policyAndQualities.first);
+        ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+
+        for (std::size_t i = 0 ; i < inputs.size() ; i++) {
+            ReadingSet* readingSet = nullptr;
+            createReadingSet(readingSet, inputs[i].first, inputs[i].second);
+            std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+            if(HasFatalFailure()) return;
+            ASSERT_NE(readingSet, nullptr);
+            ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+
+            const std::pair<std::string, std::string>& expectedQuality = policyAndQualities.second[i];
+            std::map<std::string, ReadingInfo> attributes = {
+                {"GTIS.Identifier", {"string", "M_2367_3_15_6"}},
+                {"GTIS.SpsTyp.stVal", {"int64_t", "1"}},
+                {"GTIS.SpsTyp.q.Validity", {"string", expectedQuality.first}},
+                {"GTIS.SpsTyp.q.Source", {"string", "substituted"}},
+                {"GTIS.SpsTyp.t.SecondSinceEpoch", {"int64_t_range", "1669714181;1669714183"}},
+                {"GTIS.SpsTyp.t.FractionOfSecond", {"int64_t_range", "9529451;9529453"}},
+            };
+            if (!expectedQuality.second.empty()) {
+                attributes["GTIS.SpsTyp.q.DetailQuality.oldData"] = {"int64_t", expectedQuality.second};
+            }
+            std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-3");
+            validateReading(currentReading, "TS-3", "PIVOT", allPivotAttributeNames, attributes);
+            if(HasFatalFailure()) return;
+            storedReadings = {};
+        }
+    }
+}
+
+TEST_F(PluginIngestTest, TimestampPolicies)
+{
+    std::string jsonMessageTS1_0_reset = generatePivotTS("SpsTyp", "M_2367_3_15_4", "0", "1669714100", "9529451");
+    std::string jsonMessageTS2_0_reset = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"off\"", "1669714100", "9529451");
+    std::string jsonMessageTS2_on = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"on\"", "1669714183", "9529451");
+    std::string jsonMessageTS1_0 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "0", "1669714185", "9529451");
+    std::string jsonMessageTS2_off = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"off\"", "1669714182", "9529451");
+
+    // Value and SecondSinceEpoch of TS-3 after each input, for each policy
+    const std::vector<std::pair<std::string, std::string>> inputs = {
+        {"TS-2", jsonMessageTS2_on}, {"TS-1", jsonMessageTS1_0}, {"TS-2", jsonMessageTS2_off}};
+    const std::vector<int64_t> expectedValues = {1, 1, 0};
+    const std::map<std::string, std::vector<int64_t>> expectedSeconds = {
+        {"trigger", {1669714183, 1669714185, 1669714182}},
+        {"max_of_inputs", {1669714183, 1669714185, 1669714185}},
+        {"max_of_contributing_inputs", {1669714183, 1669714183, 1669714185}},
+    };
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    for (const auto& policyAndSeconds : expectedSeconds) {
+        std::string reconfigure = QUOTE({
+            "enable": {
+                "value": "true"
+            },
+            "timestamp_policy": {
+                "value": "<policy>"
+            }
+        });
+        reconfigure = std::regex_replace(reconfigure, std::regex("<policy>"), policyAndSeconds.first);
+        ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+
+        // Inputs going back in time are accepted by default, the maxima are recomputed
+        ReadingSet* resetReadingSet = nullptr;
+        createReadingSetMultipleReadings(resetReadingSet, {{"TS-1", jsonMessageTS1_0_reset}, {"TS-2", jsonMessageTS2_0_reset}});
+        std::shared_ptr<ReadingSet> resetReadingSetCleaner(resetReadingSet);
+        if(HasFatalFailure()) return;
+        ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(resetReadingSet)));
+        storedReadings = {};
+
+        for (std::size_t i = 0 ; i < inputs.size() ; i++) {
+            ReadingSet* readingSet = nullptr;
+            createReadingSet(readingSet, inputs[i].first, inputs[i].second);
+            std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+            if(HasFatalFailure()) return;
+            ASSERT_NE(readingSet, nullptr);
+            ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+
+            std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-3");
+            ASSERT_NE(currentReading.get(), nullptr);
+            Datapoint& pivot = *getObject(*currentReading, "PIVOT");
+            ASSERT_EQ(getIntValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.stVal", getChildFn)), expectedValues[i]);
+            ASSERT_EQ(getIntValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.t.SecondSinceEpoch", getChildFn)), policyAndSeconds.second[i])
+                << policyAndSeconds.first << " input " << i;
+            ASSERT_EQ(getIntValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.t.FractionOfSecond", getChildFn)), 9529451);
+            storedReadings = {};
+        }
+    }
+}
+
+TEST_F(PluginIngestTest, RejectOutOfOrder)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "reject_out_of_order": {
+            "value": "true"
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+
+    std::string jsonMessageTS1_1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714183", "9529451");
+    std::string jsonMessageTS1_0 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "0", "1669714182", "9529451");
+    std::string jsonMessageTS2_off = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"off\"", "1669714184", "9529451");
+    std::string jsonMessageTS2_on = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"on\"", "1669714181", "9529451");
+
+    // Old readings of an input are forwarded without being used, old readings of a computed output are removed
+    const std::vector<std::pair<std::string, std::string>> inputs = {
+        {"TS-1", jsonMessageTS1_1}, {"TS-1", jsonMessageTS1_0}, {"TS-2", jsonMessageTS2_off}, {"TS-2", jsonMessageTS2_on}};
+    const std::vector<std::vector<std::string>> expectedAssets = {
+        {"TS-1", "TS-2", "TS-3"}, {"TS-1"}, {"TS-2", "TS-3"}, {}};
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    for (std::size_t i = 0 ; i < inputs.size() ; i++) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, inputs[i].first, inputs[i].second);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        if(HasFatalFailure()) return;
+        ASSERT_NE(readingSet, nullptr);
+        ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+        ASSERT_EQ(resultReading->getAllReadings().size(), expectedAssets[i].size());
+        for (const std::string& expectedAsset: expectedAssets[i]) {
+            std::shared_ptr<Reading> currentReading = popFrontReading();
+            ASSERT_NE(currentReading.get(), nullptr);
+            ASSERT_EQ(currentReading->getAssetName(), expectedAsset);
+            // The rejected reading did not change the cached value of TS-1
+            if (expectedAsset == "TS-3") {
+                ASSERT_EQ(getIntValue(*callOnLastPathElement(*getObject(*currentReading, "PIVOT"), "GTIS.SpsTyp.stVal", getChildFn)), 1);
+            }
+        }
+    }
+    ASSERT_EQ(outputHandlerCalled, 4);
+}
+
+TEST_F(PluginIngestTest, Operators)
+{
+    static std::string reconfigure = QUOTE({
+        "enable" :{
+            "value": "true"
+        },
+        "exchanged_data": {
+            "value" : {
+                "exchanged_data": {
+                    "name" : "SAMPLE",
+                    "version" : "1.0",
+                    "datapoints" : [
+                        {"label":"AND", "pivot_id":"M_10", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "and", "input": ["M_1", "M_2", "M_3"]}]},
+                        {"label":"XOR", "pivot_id":"M_11", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "xor", "input": ["M_1", "M_2", "M_3"]}]},
+                        {"label":"NOT", "pivot_id":"M_12", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "not", "input": ["M_1"]}]},
+                        {"label":"COUNT_GE", "pivot_id":"M_13", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "count_ge", "k": 2, "input": ["M_1", "M_2", "M_3", "M_4"]}]},
+                        {"label":"MAJORITY", "pivot_id":"M_14", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "majority", "input": ["M_1", "M_2", "M_3", "M_4"]}]}
+                    ]
+                }
+            }
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+    ASSERT_EQ(filter->getConfigOperation().getDataOperations().size(), 5);
+
+    // Value of the outputs generated by each input
+    const std::vector<std::pair<std::string, std::string>> inputs = {
+        {"M_1", "1"}, {"M_2", "1"}, {"M_3", "1"}, {"M_1", "0"}};
+    const std::vector<std::map<std::string, int64_t>> expectedValues = {
+        {{"AND", 0}, {"XOR", 1}, {"NOT", 0}, {"COUNT_GE", 0}, {"MAJORITY", 0}},
+        {{"AND", 0}, {"XOR", 0}, {"COUNT_GE", 1}, {"MAJORITY", 0}},
+        {{"AND", 1}, {"XOR", 1}, {"COUNT_GE", 1}, {"MAJORITY", 1}},
+        {{"AND", 0}, {"XOR", 0}, {"NOT", 1}, {"COUNT_GE", 1}, {"MAJORITY", 0}},
+    };
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    for (std::size_t i = 0 ; i < inputs.size() ; i++) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, "INPUT", generatePivotTS("SpsTyp", inputs[i].first, inputs[i].second, "1669714181", "9529451"));
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        if(HasFatalFailure()) return;
+        ASSERT_NE(readingSet, nullptr);
+        ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+
+        std::map<std::string, int64_t> values;
+        std::shared_ptr<Reading> currentReading = popFrontReading();
+        for (; currentReading != nullptr ; currentReading = popFrontReading()) {
+            if (currentReading->getAssetName() != "INPUT") {
+                values[currentReading->getAssetName()] = getIntValue(*callOnLastPathElement(*getObject(*currentReading, "PIVOT"), "GTIS.SpsTyp.stVal", getChildFn));
+            }
+        }
+        ASSERT_EQ(values, expectedValues[i]) << "input " << i;
+    }
+}
+
+TEST_F(PluginIngestTest, ChainedOperations)
+{
+    static std::string reconfigure = QUOTE({
+        "enable" :{
+            "value": "true"
+        },
+        "exchanged_data": {
+            "value" : {
+                "exchanged_data": {
+                    "name" : "SAMPLE",
+                    "version" : "1.0",
+                    "datapoints" : [
+                        {"label":"BAY-1", "pivot_id":"BAY_1", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "or", "input": ["IN_1", "IN_2"]}]},
+                        {"label":"BAY-2", "pivot_id":"BAY_2", "pivot_type":"DpsTyp",
+                         "operations": [{"operation": "or", "input": ["IN_3", "IN_4"]}]},
+                        {"label":"LEVEL", "pivot_id":"LEVEL", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "and", "input": ["BAY_1", "BAY_2"]}]},
+                        {"label":"SUBSTATION", "pivot_id":"SUBSTATION", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "or", "input": ["LEVEL", "IN_1"]}]}
+                    ]
+                }
+            }
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+
+    // Outputs generated by each reading set, in order: outputs are evaluated once, after all the chained outputs they use
+    const std::vector<std::vector<std::pair<std::string, std::string>>> inputs = {
+        {{"IN_3", "1"}},
+        {{"IN_1", "1"}},
+        {{"IN_1", "0"}, {"IN_3", "0"}},
+    };
+    const std::vector<std::vector<std::pair<std::string, std::string>>> expectedOutputs = {
+        {{"BAY-2", "on"}, {"LEVEL", "0"}, {"SUBSTATION", "0"}},
+        {{"BAY-1", "1"}, {"LEVEL", "1"}, {"SUBSTATION", "1"}},
+        {{"BAY-1", "0"}, {"BAY-2", "off"}, {"LEVEL", "0"}, {"SUBSTATION", "0"}},
+    };
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    for (std::size_t i = 0 ; i < inputs.size() ; i++) {
+        // The last reading set is coalesced
+        if (i == inputs.size() - 1) {
+            static std::string coalesce = QUOTE({
+                "enable": {
+                    "value": "true"
+                },
+                "coalesce_outputs": {
+                    "value": "true"
+                }
+            });
+            ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), coalesce));
+        }
+        std::vector<std::pair<std::string, std::string>> assetsAndJsons;
+        for (const auto& input : inputs[i]) {
+            assetsAndJsons.push_back({"INPUT", generatePivotTS("SpsTyp", input.first, input.second, "1669714181", "9529451")});
+        }
+        ReadingSet* readingSet = nullptr;
+        createReadingSetMultipleReadings(readingSet, assetsAndJsons);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        if(HasFatalFailure()) return;
+        ASSERT_NE(readingSet, nullptr);
+        ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+
+        std::vector<std::pair<std::string, std::string>> outputs;
+        std::shared_ptr<Reading> currentReading = popFrontReading();
+        for (; currentReading != nullptr ; currentReading = popFrontReading()) {
+            if (currentReading->getAssetName() == "INPUT") {
+                continue;
+            }
+            Datapoint& pivot = *getObject(*currentReading, "PIVOT");
+            if (currentReading->getAssetName() == "BAY-2") {
+                outputs.push_back({currentReading->getAssetName(), getStrValue(*callOnLastPathElement(pivot, "GTIS.DpsTyp.stVal", getChildFn))});
+            }
+            else {
+                outputs.push_back({currentReading->getAssetName(),
+                                   std::to_string(getIntValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.stVal", getChildFn)))});
+            }
+        }
+        ASSERT_EQ(outputs, expectedOutputs[i]) << "reading set " << i;
+    }
+}
+
+TEST_F(PluginIngestTest, Expressions)
+{
+    static std::string reconfigure = QUOTE({
+        "enable" :{
+            "value": "true"
+        },
+        "exchanged_data": {
+            "value" : {
+                "exchanged_data": {
+                    "name" : "SAMPLE",
+                    "version" : "1.0",
+                    "datapoints" : [
+                        {"label":"EXPR_LOGIC", "pivot_id":"M_20", "pivot_type":"SpsTyp",
+                         "operations": [{"expression": "(M_1 or M_2) and not M_3"}]},
+                        {"label":"EXPR_COUNT_GE", "pivot_id":"M_21", "pivot_type":"SpsTyp",
+                         "operations": [{"expression": "count(M_1, M_2, M_3, M_4) >= 2"}]},
+                        {"label":"EXPR_COUNT_EQ", "pivot_id":"M_22", "pivot_type":"SpsTyp",
+                         "operations": [{"expression": "count(M_1, M_2, M_3) == 1"}]},
+                        {"label":"EXPR_OTHER_INPUT", "pivot_id":"M_23", "pivot_type":"SpsTyp",
+                         "operations": [{"expression": "not M_4"}]}
+                    ]
+                }
+            }
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+    ASSERT_EQ(filter->getConfigOperation().getDataOperations().size(), 4);
+
+    // Only the expressions referencing the changed input are evaluated
+    const std::vector<std::pair<std::string, std::string>> inputs = {
+        {"M_1", "1"}, {"M_2", "1"}, {"M_3", "1"}, {"M_1", "0"}};
+    const std::vector<std::map<std::string, int64_t>> expectedValues = {
+        {{"EXPR_LOGIC", 1}, {"EXPR_COUNT_GE", 0}, {"EXPR_COUNT_EQ", 1}},
+        {{"EXPR_LOGIC", 1}, {"EXPR_COUNT_GE", 1}, {"EXPR_COUNT_EQ", 0}},
+        {{"EXPR_LOGIC", 0}, {"EXPR_COUNT_GE", 1}, {"EXPR_COUNT_EQ", 0}},
+        {{"EXPR_LOGIC", 0}, {"EXPR_COUNT_GE", 1}, {"EXPR_COUNT_EQ", 0}},
+    };
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    for (std::size_t i = 0 ; i < inputs.size() ; i++) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, "INPUT", generatePivotTS("SpsTyp", inputs[i].first, inputs[i].second, "1669714181", "9529451"));
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        if(HasFatalFailure()) return;
+        ASSERT_NE(readingSet, nullptr);
+        ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+
+        std::map<std::string, int64_t> values;
+        std::shared_ptr<Reading> currentReading = popFrontReading();
+        for (; currentReading != nullptr ; currentReading = popFrontReading()) {
+            if (currentReading->getAssetName() != "INPUT") {
+                values[currentReading->getAssetName()] = getIntValue(*callOnLastPathElement(*getObject(*currentReading, "PIVOT"), "GTIS.SpsTyp.stVal", getChildFn));
+            }
+        }
+        ASSERT_EQ(values, expectedValues[i]) << "input " << i;
+    }
+}
+
+TEST_F(PluginIngestTest, StateRestoredOnRestart)
+{
+    char directoryTemplate[] = "/tmp/spoperators_stateXXXXXX";
+    ASSERT_NE(mkdtemp(directoryTemplate), nullptr);
+    const std::string stateFile = std::string(directoryTemplate) + "/state";
+    const std::string stateFileConfig = ", \"state_file\": {\"value\": \"" + stateFile + "\"}";
+    std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        }
+    });
+    reconfigure.insert(reconfigure.rfind('}'), stateFileConfig);
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+
+    std::string jsonMessageTS2_on = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"on\"", "1669714181", "9529451");
+    std::string jsonMessageTS1_0 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "0", "1669714182", "9529451");
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    auto ingestAndGetTS3 = [&](const std::string& assetName, const std::string& json) -> int64_t {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, assetName, json);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        plugin_ingest(filter, static_cast<READINGSET*>(readingSet));
+        std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-3");
+        storedReadings = {};
+        if (currentReading == nullptr) {
+            return -1;
+        }
+        return getIntValue(*callOnLastPathElement(*getObject(*currentReading, "PIVOT"), "GTIS.SpsTyp.stVal", getChildFn));
+    };
+    ASSERT_EQ(ingestAndGetTS3("TS-2", jsonMessageTS2_on), 1);
+
+    // Restart: the state of TS-2 is read from the state file, TS-3 stays on
+    std::string initConfig = test_config;
+    initConfig.insert(initConfig.rfind('}'), stateFileConfig);
+    ConfigCategory config("operationsp", initConfig);
+    plugin_shutdown(static_cast<PLUGIN_HANDLE>(filter));
+    filter = static_cast<FilterOperationSp*>(plugin_init(&config, &resultReading, testOutputStream));
+    ASSERT_EQ(ingestAndGetTS3("TS-1", jsonMessageTS1_0), 1);
+
+    // Restart with a maximum age: the state of TS-2 is too old to be restored
+    std::string staleConfig = initConfig;
+    staleConfig.insert(staleConfig.rfind('}'), ", \"state_max_age\": {\"value\": \"3600\"}");
+    ConfigCategory staleCategory("operationsp", staleConfig);
+    plugin_shutdown(static_cast<PLUGIN_HANDLE>(filter));
+    filter = static_cast<FilterOperationSp*>(plugin_init(&staleCategory, &resultReading, testOutputStream));
+    ASSERT_EQ(ingestAndGetTS3("TS-1", jsonMessageTS1_0), 0);
+
+    plugin_shutdown(static_cast<PLUGIN_HANDLE>(filter));
+    filter = nullptr;
+    unlink(stateFile.c_str());
+    unlink((stateFile + ".journal").c_str());
+    rmdir(directoryTemplate);
+}
+
+TEST_F(PluginIngestTest, UnknownInputs)
+{
+    std::string jsonMessageTS1_1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+    std::string jsonMessageTS1_0 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "0", "1669714182", "9529451");
+    std::string jsonMessageTS2_off = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"off\"", "1669714183", "9529451");
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    auto setPolicy = [&](const std::string& policy, const std::string& ratio) {
+        std::string reconfigure = QUOTE({
+            "enable": {
+                "value": "true"
+            },
+            "unknown_input_policy": {
+                "value": "<policy>"
+            },
+            "known_inputs_ratio": {
+                "value": "<ratio>"
+            }
+        });
+        reconfigure = std::regex_replace(reconfigure, std::regex("<policy>"), policy);
+        reconfigure = std::regex_replace(reconfigure, std::regex("<ratio>"), ratio);
+        plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure);
+    };
+    auto ingestAndGetTS3 = [&](const std::string& assetName, const std::string& json) -> std::shared_ptr<Reading> {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, assetName, json);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        plugin_ingest(filter, static_cast<READINGSET*>(readingSet));
+        std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-3");
+        storedReadings = {};
+        return currentReading;
+    };
+
+    // TS-2 was never received: the output of TS-3 is flagged
+    setPolicy("questionable", "1.0");
+    std::shared_ptr<Reading> currentReading = ingestAndGetTS3("TS-1", jsonMessageTS1_1);
+    ASSERT_NE(currentReading.get(), nullptr);
+    Datapoint* pivot = getObject(*currentReading, "PIVOT");
+    ASSERT_EQ(getIntValue(*callOnLastPathElement(*pivot, "GTIS.SpsTyp.stVal", getChildFn)), 1);
+    ASSERT_EQ(getStrValue(*callOnLastPathElement(*pivot, "GTIS.SpsTyp.q.Validity", getChildFn)), "questionable");
+
+    // Or not generated at all
+    setPolicy("withhold", "1.0");
+    ASSERT_EQ(ingestAndGetTS3("TS-1", jsonMessageTS1_0).get(), nullptr);
+
+    // Unless enough of the inputs are known
+    setPolicy("withhold", "0.5");
+    currentReading = ingestAndGetTS3("TS-1", jsonMessageTS1_1);
+    ASSERT_NE(currentReading.get(), nullptr);
+    pivot = getObject(*currentReading, "PIVOT");
+    ASSERT_EQ(getStrValue(*callOnLastPathElement(*pivot, "GTIS.SpsTyp.q.Validity", getChildFn)), "good");
+
+    // All the inputs are known
+    setPolicy("withhold", "1.0");
+    currentReading = ingestAndGetTS3("TS-2", jsonMessageTS2_off);
+    ASSERT_NE(currentReading.get(), nullptr);
+    ASSERT_EQ(getIntValue(*callOnLastPathElement(*getObject(*currentReading, "PIVOT"), "GTIS.SpsTyp.stVal", getChildFn)), 1);
+}
+
+TEST_F(PluginIngestTest, WithheldOutputKeepsInput)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "unknown_input_policy": {
+            "value": "withhold"
+        },
+        "known_inputs_ratio": {
+            "value": "1.0"
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+
+    // TS-2 is an input of its own operation: while TS-1 is unknown, its reading passes through unchanged
+    std::string jsonMessageTS2_on = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"on\"", "1669714181", "9529451");
+    ReadingSet* readingSet = nullptr;
+    createReadingSet(readingSet, "TS-2", jsonMessageTS2_on);
+    std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+    if(HasFatalFailure()) return;
+    ASSERT_NO_THROW(plugin_ingest(filter, static_cast<READINGSET*>(readingSet)));
+    std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("TS-2");
+    validateReading(currentReading, "TS-2", "PIVOT", allPivotAttributeNames, {
+        {"GTIS.Identifier", {"string", "M_2367_3_15_5"}},
+        {"GTIS.DpsTyp.stVal", {"string", "on"}},
+        {"GTIS.DpsTyp.q.Validity", {"string", "good"}},
+        {"GTIS.DpsTyp.q.Source", {"string", "process"}},
+        {"GTIS.DpsTyp.t.SecondSinceEpoch", {"int64_t", "1669714181"}},
+        {"GTIS.DpsTyp.t.FractionOfSecond", {"int64_t", "9529451"}},
+    });
+    if(HasFatalFailure()) return;
+    ASSERT_EQ(popFrontReadingsUntil("TS-3").get(), nullptr);
+}
+
+TEST_F(PluginIngestTest, ParallelIngest)
+{
+    // Independent groups of operations, each one with a chained output and an output that is also one of its inputs
+    const int groupCount = 40;
+    std::string datapoints;
+    for (int group = 0 ; group < groupCount ; group++) {
+        std::string g = std::to_string(group);
+        datapoints += std::string(group > 0 ? "," : "") +
+            "{\"label\":\"OR-" + g + "\", \"pivot_id\":\"OR_" + g + "\", \"pivot_type\":\"SpsTyp\","
+            " \"operations\": [{\"operation\": \"or\", \"input\": [\"IN_" + g + "_0\", \"IN_" + g + "_1\"]}]},"
+            "{\"label\":\"AND-" + g + "\", \"pivot_id\":\"AND_" + g + "\", \"pivot_type\":\"SpsTyp\","
+            " \"operations\": [{\"operation\": \"and\", \"input\": [\"OR_" + g + "\", \"IN_" + g + "_2\"]}]},"
+            "{\"label\":\"SELF-" + g + "\", \"pivot_id\":\"SELF_" + g + "\", \"pivot_type\":\"SpsTyp\","
+            " \"operations\": [{\"operation\": \"xor\", \"input\": [\"IN_" + g + "_2\", \"SELF_" + g + "\"]}]}";
+    }
+    auto ingestAll = [&](const std::string& workerThreads) -> std::vector<std::string> {
+        plugin_shutdown(static_cast<PLUGIN_HANDLE>(filter));
+        filter = static_cast<FilterOperationSp*>(plugin_init(nullptr, &resultReading, testOutputStream));
+        std::string reconfigure = "{\"enable\": {\"value\": \"true\"}, \"reject_out_of_order\": {\"value\": \"true\"},"
+                                  " \"worker_threads\": {\"value\": \"" + workerThreads + "\"},"
+                                  " \"exchanged_data\": {\"value\": {\"exchanged_data\": {\"datapoints\": [" + datapoints + "]}}}}";
+        plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure);
+
+        std::vector<std::string> outputs;
+        unsigned int random = 12345;
+        for (int readingSetIndex = 0 ; readingSetIndex < 3 ; readingSetIndex++) {
+            std::vector<std::pair<std::string, std::string>> assetsAndJsons;
+            for (int i = 0 ; i < 1000 ; i++) {
+                random = random * 1103515245 + 12345;
+                std::string group = std::to_string((random >> 8) % groupCount);
+                int input = (random >> 16) % 5;
+                std::string pivotId = (input == 4) ? "SELF_" + group : "IN_" + group + "_" + std::to_string(input);
+                // Readings not involved in operations and readings older than the last one of their input are mixed in
+                if (i % 13 == 0) {
+                    pivotId = "UNUSED";
+                }
+                std::string seconds = std::to_string(1669714181 + readingSetIndex * 1000 + i - ((random >> 24) % 4 == 0 ? 50 : 0));
+                assetsAndJsons.push_back({"INPUT", generatePivotTS("SpsTyp", pivotId, std::to_string((random >> 12) & 1), seconds, "0")});
+            }
+            ReadingSet* readingSet = nullptr;
+            createReadingSetMultipleReadings(readingSet, assetsAndJsons);
+            std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+            plugin_ingest(filter, static_cast<READINGSET*>(readingSet));
+            for (std::shared_ptr<Reading> currentReading = popFrontReading() ; currentReading != nullptr ; currentReading = popFrontReading()) {
+                outputs.push_back(currentReading->getAssetName() + " " + currentReading->toJSON());
+            }
+        }
+        return outputs;
+    };
+
+    std::vector<std::string> sequentialOutputs = ingestAll("0");
+    ASSERT_GT(sequentialOutputs.size(), 3000);
+    ASSERT_EQ(filter->getConfigOperation().getComponentCount(), groupCount);
+    // Same readings in the same order whatever the number of threads
+    ASSERT_EQ(ingestAll("4"), sequentialOutputs);
+    ASSERT_EQ(ingestAll("3"), sequentialOutputs);
+}
+
+TEST_F(PluginIngestTest, Metrics)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "emit_policy": {
+            "value": "on-change"
+        },
+        "metrics_interval": {
+            "value": "3600"
+        },
+        "metrics_asset": {
+            "value": "METRICS"
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+    std::string jsonMessageTS1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+    std::string jsonMessageUnknown = generatePivotTS("SpsTyp", "UNKNOWN", "1", "1669714181", "9529451");
+    std::string jsonMessageNoPivot = QUOTE({"OTHER": {"value": 1}});
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    auto ingest = [&](const std::vector<std::pair<std::string, std::string>>& assetsAndJsons) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSetMultipleReadings(readingSet, assetsAndJsons);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        plugin_ingest(filter, static_cast<READINGSET*>(readingSet));
+    };
+
+    // The first reading set sends the metrics
+    ingest({{"TS-1", jsonMessageTS1}, {"OTHER", jsonMessageUnknown}, {"OTHER", jsonMessageNoPivot}});
+    const IngestMetrics& metrics = filter->getMetrics();
+    ASSERT_EQ(metrics.get(MetricCounter::ReadingsIn), 3);
+    ASSERT_EQ(metrics.get(MetricCounter::ReadingsMatched), 1);
+    ASSERT_EQ(metrics.get(MetricCounter::IgnoredNoOperation), 1);
+    ASSERT_EQ(metrics.get(MetricCounter::IgnoredMissingPivot), 1);
+    ASSERT_EQ(metrics.get(MetricCounter::OutputsGenerated), 2);
+    ASSERT_EQ(metrics.get(MetricCounter::OutputsSuppressed), 0);
+    ASSERT_EQ(metrics.ingestLatency.getCount(), 1);
+    ASSERT_GE(metrics.configLatency.getCount(), 1);
+    std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("METRICS");
+    ASSERT_NE(currentReading.get(), nullptr);
+    Datapoint* metricsDatapoint = getObject(*currentReading, "metrics");
+    ASSERT_NE(metricsDatapoint, nullptr);
+    ASSERT_EQ(getIntValue(*callOnLastPathElement(*metricsDatapoint, "readings_in", getChildFn)), 3);
+    ASSERT_EQ(getIntValue(*callOnLastPathElement(*metricsDatapoint, "outputs_generated", getChildFn)), 2);
+    ASSERT_EQ(getIntValue(*callOnLastPathElement(*metricsDatapoint, "ingest_latency.count", getChildFn)), 1);
+    storedReadings = {};
+
+    // Unchanged outputs are suppressed, the next metrics are only sent once the interval elapsed
+    ingest({{"TS-1", jsonMessageTS1}});
+    ASSERT_EQ(metrics.get(MetricCounter::ReadingsIn), 4);
+    ASSERT_EQ(metrics.get(MetricCounter::OutputsSuppressed), 2);
+    ASSERT_EQ(metrics.ingestLatency.getCount(), 2);
+    ASSERT_EQ(popFrontReadingsUntil("METRICS").get(), nullptr);
+}
+
+TEST_F(PluginIngestTest, OperationStats)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "emit_policy": {
+            "value": "on-change"
+        },
+        "operation_stats": {
+            "value": "true"
+        },
+        "metrics_interval": {
+            "value": "3600"
+        }
+    });
+    // Nothing evaluated yet
+    ASSERT_EQ(filter->getOperationStatsReport(), "{\"operations\":[]}");
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+    std::string jsonMessageTS1 = generatePivotTS("SpsTyp", "M_2367_3_15_4", "1", "1669714181", "9529451");
+    std::string jsonMessageTS2 = generatePivotTS("DpsTyp", "M_2367_3_15_5", "\"off\"", "1669714182", "9529451");
+    std::vector<std::pair<std::string, std::string>> assetsAndJsons = {{"TS-1", jsonMessageTS1}, {"TS-1", jsonMessageTS1}};
+    ReadingSet* readingSet = nullptr;
+    createReadingSetMultipleReadings(readingSet, assetsAndJsons);
+    std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+    plugin_ingest(filter, static_cast<READINGSET*>(readingSet));
+
+    // Both outputs are evaluated twice, the second value is unchanged
+    std::string report = filter->getOperationStatsReport();
+    for (const char* pivotId : {"M_2367_3_15_5", "M_2367_3_15_6"}) {
+        std::regex outputStats(std::string("\\{\"pivot_id\":\"") + pivotId + "\",\"inputs\":2,\"evaluations\":2,\"emitted\":1,\"suppressed\":1,"
+                               "\"average_processing_ns\":[0-9]+,\"total_processing_ns\":[0-9]+\\}");
+        ASSERT_TRUE(std::regex_search(report, outputStats)) << report;
+    }
+    // The input reading of TS-2 is rewritten in place with the value of its own operation
+    createReadingSet(readingSet, "TS-2", jsonMessageTS2);
+    std::shared_ptr<ReadingSet> readingSetCleaner2(readingSet);
+    plugin_ingest(filter, static_cast<READINGSET*>(readingSet));
+    report = filter->getOperationStatsReport(1);
+    ASSERT_EQ(std::count(report.begin(), report.end(), '{'), 2) << report;
+
+    // The most expensive outputs are listed in the metrics reading
+    std::shared_ptr<Reading> currentReading = popFrontReadingsUntil(ConstantsOperation::ValueMetricsAsset);
+    ASSERT_NE(currentReading.get(), nullptr);
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    std::string topOperations = getStrValue(*callOnLastPathElement(*getObject(*currentReading, "metrics"), "top_operations", getChildFn));
+    ASSERT_NE(topOperations.find("\"pivot_id\":\"M_2367_3_15_6\""), std::string::npos) << topOperations;
+}
+
+TEST_F(PluginIngestTest, ContributingInputsOfParityOperations)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "quality_policy": {
+            "value": "contributing"
+        },
+        "timestamp_policy": {
+            "value": "max_of_contributing_inputs"
+        },
+        "exchanged_data": {
+            "value" : {
+                "exchanged_data": {
+                    "datapoints" : [
+                        {"label":"NOT-OUT", "pivot_id":"NOT_OUT", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "not", "input": ["IN_1"]}]},
+                        {"label":"XOR-OUT", "pivot_id":"XOR_OUT", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "xor", "input": ["IN_1", "IN_2"]}]},
+                        {"label":"EXPR-OUT", "pivot_id":"EXPR_OUT", "pivot_type":"SpsTyp",
+                         "operations": [{"expression": "not IN_1"}]}
+                    ]
+                }
+            }
+        }
+    });
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), reconfigure));
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    auto ingest = [&](const std::string& json) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, "INPUT", json);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        plugin_ingest(filter, static_cast<READINGSET*>(readingSet));
+    };
+    auto checkOutput = [&](const std::string& assetName, int64_t value, const std::string& validity, int64_t seconds) {
+        std::shared_ptr<Reading> currentReading = popFrontReadingsUntil(assetName);
+        ASSERT_NE(currentReading.get(), nullptr) << assetName;
+        Datapoint& pivot = *getObject(*currentReading, "PIVOT");
+        ASSERT_EQ(getIntValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.stVal", getChildFn)), value) << assetName;
+        ASSERT_EQ(getStrValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.q.Validity", getChildFn)), validity) << assetName;
+        ASSERT_EQ(getIntValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.t.SecondSinceEpoch", getChildFn)), seconds) << assetName;
+    };
+
+    // The output of not is off while its only input is on: its invalid quality is still the one of the output
+    ingest(std::regex_replace(generatePivotTS("SpsTyp", "IN_1", "1", "1669714100", "0"), std::regex("good"), "invalid"));
+    checkOutput("NOT-OUT", 0, "invalid", 1669714100);
+    checkOutput("EXPR-OUT", 0, "invalid", 1669714100);
+    storedReadings = {};
+
+    // Both inputs of xor are on and its output is off: all the inputs contribute to it
+    ingest(generatePivotTS("SpsTyp", "IN_2", "1", "1669714050", "0"));
+    checkOutput("XOR-OUT", 0, "invalid", 1669714100);
+}
+
+TEST_F(PluginIngestTest, QualityPolicySwitch)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "quality_policy": {
+            "value": "<policy>"
+        },
+        "exchanged_data": {
+            "value" : {
+                "exchanged_data": {
+                    "datapoints" : [
+                        {"label":"OR-OUT", "pivot_id":"OR_OUT", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "or", "input": ["IN_1", "IN_2"]}]}
+                    ]
+                }
+            }
+        }
+    });
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    auto ingest = [&](const std::string& json) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, "INPUT", json);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        plugin_ingest(filter, static_cast<READINGSET*>(readingSet));
+    };
+    auto checkOutput = [&](int64_t value, const std::string& validity) {
+        std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("OR-OUT");
+        ASSERT_NE(currentReading.get(), nullptr);
+        Datapoint& pivot = *getObject(*currentReading, "PIVOT");
+        ASSERT_EQ(getIntValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.stVal", getChildFn)), value);
+        ASSERT_EQ(getStrValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.q.Validity", getChildFn)), validity);
+        storedReadings = {};
+    };
+
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), std::regex_replace(reconfigure, std::regex("<policy>"), "trigger")));
+    ingest(generatePivotTS("SpsTyp", "IN_2", "0", "1669714100", "0"));
+    checkOutput(0, "good");
+    ingest(std::regex_replace(generatePivotTS("SpsTyp", "IN_1", "1", "1669714101", "0"), std::regex("good"), "invalid"));
+    checkOutput(1, "invalid");
+
+    // The quality counts are built from the known inputs when a policy needs them, then maintained
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), std::regex_replace(reconfigure, std::regex("<policy>"), "worst_of")));
+    ingest(std::regex_replace(generatePivotTS("SpsTyp", "IN_1", "1", "1669714102", "0"), std::regex("good"), "invalid"));
+    checkOutput(1, "invalid");
+    ingest(generatePivotTS("SpsTyp", "IN_2", "1", "1669714103", "0"));
+    checkOutput(1, "invalid");
+
+    // They are dropped again with the trigger policy and rebuilt on the next switch
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), std::regex_replace(reconfigure, std::regex("<policy>"), "trigger")));
+    ingest(generatePivotTS("SpsTyp", "IN_2", "0", "1669714104", "0"));
+    checkOutput(1, "good");
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), std::regex_replace(reconfigure, std::regex("<policy>"), "worst_of")));
+    ingest(generatePivotTS("SpsTyp", "IN_1", "1", "1669714105", "0"));
+    checkOutput(1, "good");
+    ingest(std::regex_replace(generatePivotTS("SpsTyp", "IN_2", "1", "1669714106", "0"), std::regex("good"), "questionable"));
+    checkOutput(1, "questionable");
+}
+
+TEST_F(PluginIngestTest, TimestampPolicySwitch)
+{
+    static std::string reconfigure = QUOTE({
+        "enable": {
+            "value": "true"
+        },
+        "timestamp_policy": {
+            "value": "<policy>"
+        },
+        "exchanged_data": {
+            "value" : {
+                "exchanged_data": {
+                    "datapoints" : [
+                        {"label":"OR-OUT", "pivot_id":"OR_OUT", "pivot_type":"SpsTyp",
+                         "operations": [{"operation": "or", "input": ["IN_1", "IN_2"]}]}
+                    ]
+                }
+            }
+        }
+    });
+    std::function<Datapoint*(Datapoint&, const std::string&)> getChildFn(&getChild);
+    auto ingest = [&](const std::string& json) {
+        ReadingSet* readingSet = nullptr;
+        createReadingSet(readingSet, "INPUT", json);
+        std::shared_ptr<ReadingSet> readingSetCleaner(readingSet);
+        plugin_ingest(filter, static_cast<READINGSET*>(readingSet));
+    };
+    auto checkOutput = [&](int64_t seconds) {
+        std::shared_ptr<Reading> currentReading = popFrontReadingsUntil("OR-OUT");
+        ASSERT_NE(currentReading.get(), nullptr);
+        Datapoint& pivot = *getObject(*currentReading, "PIVOT");
+        ASSERT_EQ(getIntValue(*callOnLastPathElement(pivot, "GTIS.SpsTyp.t.SecondSinceEpoch", getChildFn)), seconds);
+        storedReadings = {};
+    };
+
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), std::regex_replace(reconfigure, std::regex("<policy>"), "trigger")));
+    ingest(generatePivotTS("SpsTyp", "IN_2", "0", "1669714100", "0"));
+    checkOutput(1669714100);
+    ingest(generatePivotTS("SpsTyp", "IN_1", "1", "1669714101", "0"));
+    checkOutput(1669714101);
+
+    // The timestamp maxima are built from the known inputs when a policy needs them, then maintained
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), std::regex_replace(reconfigure, std::regex("<policy>"), "max_of_inputs")));
+    ingest(generatePivotTS("SpsTyp", "IN_2", "1", "1669714105", "0"));
+    checkOutput(1669714105);
+    ingest(generatePivotTS("SpsTyp", "IN_1", "0", "1669714103", "0"));
+    checkOutput(1669714105);
+
+    // They are dropped again with the trigger policy and rebuilt on the next switch
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), std::regex_replace(reconfigure, std::regex("<policy>"), "trigger")));
+    ingest(generatePivotTS("SpsTyp", "IN_1", "1", "1669714102", "0"));
+    checkOutput(1669714102);
+    ASSERT_NO_THROW(plugin_reconfigure(static_cast<PLUGIN_HANDLE>(filter), std::regex_replace(reconfigure, std::regex("<policy>"), "max_of_inputs")));
+    ingest(generatePivotTS("SpsTyp", "IN_1", "0", "1669714112", "0"));
+    checkOutput(1669714112);
+    ingest(generatePivotTS("SpsTyp", "IN_2", "0", "1669714111", "0"));
+    checkOutput(1669714112);
+}
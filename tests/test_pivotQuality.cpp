@@ -0,0 +1,54 @@
+#include "pivotQuality.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+// Dummy object used to be able to call parseJson() freely
+static DatapointValue dummyValue("");
+static Datapoint dummyDataPoint({}, dummyValue);
+
+static uint16_t encodeJson(const std::string& json) {
+    std::vector<Datapoint*> *q = dummyDataPoint.parseJson(json);
+    uint16_t mask = PivotQuality::encode(q);
+    for (Datapoint* dp : *q) {
+        delete dp;
+    }
+    delete q;
+    return mask;
+}
+
+TEST(PivotQualityTest, Encode)
+{
+    ASSERT_EQ(PivotQuality::encode(nullptr), PivotQuality::ValidityGood);
+    ASSERT_EQ(encodeJson(R"({"Source": "process", "Validity": "good"})"), PivotQuality::ValidityGood);
+    ASSERT_EQ(encodeJson(R"({"Validity": "invalid"})"), PivotQuality::ValidityInvalid);
+    ASSERT_EQ(encodeJson(R"({"Validity": "questionable"})"), PivotQuality::ValidityQuestionable);
+
+    // Source does not change the mask, every other attribute does
+    ASSERT_EQ(encodeJson(R"({"Source": "substituted", "Validity": "good"})"), PivotQuality::ValidityGood);
+    uint16_t oldData = encodeJson(R"({"DetailQuality": {"oldData": 1}, "Validity": "questionable"})");
+    ASSERT_EQ(oldData & PivotQuality::ValidityMask, PivotQuality::ValidityQuestionable);
+    ASSERT_NE(oldData & PivotQuality::DetailQualityMask, 0);
+    uint16_t failure = encodeJson(R"({"DetailQuality": {"failure": 1}, "Validity": "questionable"})");
+    ASSERT_NE(oldData, failure);
+    ASSERT_EQ(encodeJson(R"({"DetailQuality": {"oldData": 0}})"), PivotQuality::ValidityGood);
+    ASSERT_EQ(encodeJson(R"({"test": 1})"), PivotQuality::TestFlag);
+    ASSERT_EQ(encodeJson(R"({"operatorBlocked": 1})"), PivotQuality::OperatorBlockedFlag);
+}
+
+TEST(PivotQualityTest, Apply)
+{
+    std::vector<Datapoint*> *q = dummyDataPoint.parseJson(R"({"Source": "substituted", "Validity": "good", "DetailQuality": {"failure": 1}})");
+    uint16_t mask = encodeJson(R"({"DetailQuality": {"oldData": 1}, "Validity": "invalid", "test": 1})");
+    PivotQuality::apply(q, mask);
+    ASSERT_EQ(PivotQuality::encode(q), mask);
+    PivotQuality::apply(q, PivotQuality::ValidityGood);
+    ASSERT_EQ(PivotQuality::encode(q), PivotQuality::ValidityGood);
+    // Source is kept, only the validity remains of the quality attributes
+    ASSERT_EQ(q->size(), 2);
+    for (Datapoint* dp : *q) {
+        delete dp;
+    }
+    delete q;
+}
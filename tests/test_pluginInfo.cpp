@@ -35,5 +35,6 @@ TEST(PluginInfoTest, PluginInfoConfigParse)
     ASSERT_EQ(doc.IsObject(), true);
     ASSERT_EQ(doc.HasMember("plugin"), true);
     ASSERT_EQ(doc.HasMember("enable"), true);
+    ASSERT_EQ(doc.HasMember("emit_policy"), true);
     ASSERT_EQ(doc.HasMember("exchanged_data"), true);
 }
@@ -0,0 +1,77 @@
+#include "pointState.h"
+
+#include <gtest/gtest.h>
+
+TEST(PointStateTest, DecodeDps)
+{
+    ASSERT_EQ(PointState::decodeDps("off"), PointState::StateOff);
+    ASSERT_EQ(PointState::decodeDps("on"), PointState::StateOn);
+    ASSERT_EQ(PointState::decodeDps("intermediate-state"), PointState::StateIntermediate);
+    ASSERT_EQ(PointState::decodeDps("bad-state"), PointState::StateBad);
+    ASSERT_EQ(PointState::decodeDps("no"), PointState::StateBad);
+    ASSERT_EQ(PointState::decodeDps(""), PointState::StateBad);
+    for (int state = 0 ; state < PointState::StateCount ; state++) {
+        ASSERT_EQ(PointState::decodeDps(PointState::encodeDps(state)), state);
+    }
+}
+
+TEST(PointStateTest, StateCounts)
+{
+    uint64_t counts = StateCounts::unit(PointState::StateOff) + StateCounts::unit(PointState::StateIntermediate)
+                      + StateCounts::unit(PointState::StateBad) + StateCounts::unit(PointState::StateOn);
+    ASSERT_EQ(StateCounts::count(counts, PointState::StateOff), 0);
+    ASSERT_EQ(StateCounts::count(counts, PointState::StateIntermediate), 1);
+    ASSERT_EQ(StateCounts::count(counts, PointState::StateOn), 1);
+    ASSERT_EQ(StateCounts::count(counts, PointState::StateBad), 1);
+
+    // An input moving from one state to another is a single addition
+    counts += StateCounts::unit(PointState::StateOff) - StateCounts::unit(PointState::StateOn);
+    counts += StateCounts::unit(PointState::StateIntermediate) - StateCounts::unit(PointState::StateBad);
+    ASSERT_EQ(StateCounts::count(counts, PointState::StateOn), 0);
+    ASSERT_EQ(StateCounts::count(counts, PointState::StateBad), 0);
+    ASSERT_EQ(StateCounts::count(counts, PointState::StateIntermediate), 2);
+}
+
+TEST(PointStateTest, EvaluateThreshold)
+{
+    // Threshold of 2 out of 3 inputs
+    uint64_t counts = 0;
+    ASSERT_EQ(StateCounts::evaluateThreshold(counts, 2), PointState::StateOff);
+    counts += StateCounts::unit(PointState::StateOn);
+    ASSERT_EQ(StateCounts::evaluateThreshold(counts, 2), PointState::StateOff);
+    counts += StateCounts::unit(PointState::StateIntermediate);
+    ASSERT_EQ(StateCounts::evaluateThreshold(counts, 2), PointState::StateIntermediate);
+    counts += StateCounts::unit(PointState::StateBad);
+    ASSERT_EQ(StateCounts::evaluateThreshold(counts, 2), PointState::StateBad);
+    counts += StateCounts::unit(PointState::StateOn) - StateCounts::unit(PointState::StateBad);
+    ASSERT_EQ(StateCounts::evaluateThreshold(counts, 2), PointState::StateOn);
+
+    // A threshold of 1 is an "or": on if any input is on, else bad if any input is bad, else intermediate if any input is intermediate
+    const std::vector<std::pair<uint64_t, int>> orCases = {
+        {0, PointState::StateOff},
+        {StateCounts::unit(PointState::StateIntermediate), PointState::StateIntermediate},
+        {StateCounts::unit(PointState::StateBad), PointState::StateBad},
+        {StateCounts::unit(PointState::StateIntermediate) + StateCounts::unit(PointState::StateBad), PointState::StateBad},
+        {StateCounts::unit(PointState::StateOn) + StateCounts::unit(PointState::StateBad), PointState::StateOn},
+    };
+    for (const auto& orCase : orCases) {
+        ASSERT_EQ(StateCounts::evaluateThreshold(orCase.first, 1), orCase.second);
+    }
+}
+
+TEST(PointStateTest, EvaluateParity)
+{
+    uint64_t counts = 0;
+    ASSERT_EQ(StateCounts::evaluateParity(counts, 0), PointState::StateOff);
+    ASSERT_EQ(StateCounts::evaluateParity(counts, 1), PointState::StateOn);
+    counts += StateCounts::unit(PointState::StateOn);
+    ASSERT_EQ(StateCounts::evaluateParity(counts, 0), PointState::StateOn);
+    ASSERT_EQ(StateCounts::evaluateParity(counts, 1), PointState::StateOff);
+    counts += StateCounts::unit(PointState::StateOn);
+    ASSERT_EQ(StateCounts::evaluateParity(counts, 0), PointState::StateOff);
+    counts += StateCounts::unit(PointState::StateIntermediate);
+    ASSERT_EQ(StateCounts::evaluateParity(counts, 0), PointState::StateIntermediate);
+    counts += StateCounts::unit(PointState::StateBad);
+    ASSERT_EQ(StateCounts::evaluateParity(counts, 1), PointState::StateBad);
+}
+
@@ -0,0 +1,31 @@
+#include "qualityCounts.h"
+
+#include <gtest/gtest.h>
+
+TEST(QualityCountsTest, AggregateMasks)
+{
+    QualityCounts counts;
+    counts.reset(2);
+    ASSERT_EQ(counts.getWorstMask(0), 0);
+
+    counts.add(0, PointState::StateOn, PivotQuality::ValidityQuestionable | PivotQuality::TestFlag);
+    counts.add(0, PointState::StateOn, PivotQuality::ValidityQuestionable);
+    counts.add(0, PointState::StateOff, PivotQuality::ValidityInvalid);
+    ASSERT_EQ(counts.getMask(0, PointState::StateOn), PivotQuality::ValidityQuestionable | PivotQuality::TestFlag);
+    ASSERT_EQ(counts.getMask(0, PointState::StateOff), PivotQuality::ValidityInvalid);
+    ASSERT_EQ(counts.getWorstMask(0), PivotQuality::ValidityMask | PivotQuality::TestFlag);
+    ASSERT_EQ(counts.getWorstMask(1), 0);
+
+    // A bit is only cleared when no input has it anymore
+    counts.remove(0, PointState::StateOn, PivotQuality::ValidityQuestionable | PivotQuality::TestFlag);
+    ASSERT_EQ(counts.getMask(0, PointState::StateOn), PivotQuality::ValidityQuestionable);
+    counts.remove(0, PointState::StateOn, PivotQuality::ValidityQuestionable);
+    ASSERT_EQ(counts.getMask(0, PointState::StateOn), 0);
+
+    QualityCounts other;
+    other.reset(1);
+    other.copyOperation(0, counts, 0);
+    ASSERT_EQ(other.getWorstMask(0), PivotQuality::ValidityInvalid);
+    other.remove(0, PointState::StateOff, PivotQuality::ValidityInvalid);
+    ASSERT_EQ(other.getWorstMask(0), 0);
+}
@@ -0,0 +1,148 @@
+#include "stateStore.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include <unistd.h>
+
+namespace {
+    class StateStoreTest : public testing::Test
+    {
+    protected:
+        std::string directory;
+        std::string path;
+
+        void SetUp() override
+        {
+            char directoryTemplate[] = "/tmp/spoperators_stateXXXXXX";
+            ASSERT_NE(mkdtemp(directoryTemplate), nullptr);
+            directory = directoryTemplate;
+            path = directory + "/state";
+        }
+
+        void TearDown() override
+        {
+            unlink(path.c_str());
+            unlink((path + ".journal").c_str());
+            unlink((path + ".tmp").c_str());
+            rmdir(directory.c_str());
+        }
+
+        static PersistedInput makeInput(uint8_t state, uint16_t quality, uint64_t timestamp) {
+            PersistedInput input;
+            input.state = state;
+            input.quality = quality;
+            input.timestamp = timestamp;
+            return input;
+        }
+    };
+}
+
+TEST_F(StateStoreTest, SnapshotAndJournal)
+{
+    std::unordered_map<std::string, PersistedInput> inputs;
+    uint64_t snapshotTime = 0;
+    {
+        StateStore store;
+        ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+        ASSERT_TRUE(inputs.empty());
+        ASSERT_EQ(snapshotTime, 0);
+
+        ASSERT_TRUE(store.beginSnapshot());
+        store.addSnapshotEntry("M_1", makeInput(1, 0, 100));
+        store.addSnapshotEntry("M_2", makeInput(3, 0x0402, 200));
+        ASSERT_TRUE(store.commitSnapshot());
+
+        // Changes are replayed on top of the snapshot, the last one wins
+        store.record("M_1", makeInput(0, 0, 300));
+        store.record("M_3", makeInput(2, 0, 400));
+        store.record("M_1", makeInput(1, 0, 500));
+        ASSERT_EQ(store.getJournalRecordCount(), 3);
+        ASSERT_TRUE(store.flush());
+    }
+
+    StateStore store;
+    ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+    ASSERT_GT(snapshotTime, 0);
+    ASSERT_EQ(inputs.size(), 3);
+    ASSERT_EQ(inputs["M_1"].state, 1);
+    ASSERT_EQ(inputs["M_1"].timestamp, 500);
+    ASSERT_EQ(inputs["M_2"].quality, 0x0402);
+    ASSERT_EQ(inputs["M_3"].state, 2);
+    ASSERT_EQ(store.getJournalRecordCount(), 3);
+
+    // A new snapshot starts a new journal
+    ASSERT_TRUE(store.beginSnapshot());
+    store.addSnapshotEntry("M_4", makeInput(1, 0, 600));
+    ASSERT_TRUE(store.commitSnapshot());
+    ASSERT_EQ(store.getJournalRecordCount(), 0);
+    store.close();
+    ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+    ASSERT_EQ(inputs.size(), 1);
+    ASSERT_EQ(inputs["M_4"].timestamp, 600);
+}
+
+TEST_F(StateStoreTest, TornJournal)
+{
+    std::unordered_map<std::string, PersistedInput> inputs;
+    uint64_t snapshotTime = 0;
+    {
+        StateStore store;
+        ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+        store.record("M_1", makeInput(1, 0, 100));
+        store.record("M_2", makeInput(1, 0, 200));
+        ASSERT_TRUE(store.flush());
+    }
+    // Write interrupted in the middle of the last record
+    std::ifstream journalIn(path + ".journal", std::ios::binary);
+    std::string journal((std::istreambuf_iterator<char>(journalIn)), std::istreambuf_iterator<char>());
+    journalIn.close();
+    std::ofstream journalOut(path + ".journal", std::ios::binary | std::ios::trunc);
+    journalOut.write(journal.data(), journal.size() - 3);
+    journalOut.close();
+
+    {
+        StateStore store;
+        ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+        ASSERT_EQ(inputs.size(), 1);
+        ASSERT_EQ(inputs.count("M_1"), 1);
+        // New records are appended after the last valid one
+        store.record("M_3", makeInput(1, 0, 300));
+    }
+    StateStore store;
+    ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+    ASSERT_EQ(inputs.size(), 2);
+    ASSERT_EQ(inputs.count("M_3"), 1);
+}
+
+TEST_F(StateStoreTest, JournalOfOlderSnapshotIgnored)
+{
+    std::unordered_map<std::string, PersistedInput> inputs;
+    uint64_t snapshotTime = 0;
+    std::string oldJournal;
+    {
+        StateStore store;
+        ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+        store.record("M_1", makeInput(0, 0, 100));
+        ASSERT_TRUE(store.flush());
+        std::ifstream journalIn(path + ".journal", std::ios::binary);
+        oldJournal.assign((std::istreambuf_iterator<char>(journalIn)), std::istreambuf_iterator<char>());
+
+        ASSERT_TRUE(store.beginSnapshot());
+        store.addSnapshotEntry("M_1", makeInput(1, 0, 200));
+        ASSERT_TRUE(store.commitSnapshot());
+    }
+    // Crash after the snapshot was replaced but before the journal was reset
+    std::ofstream journalOut(path + ".journal", std::ios::binary | std::ios::trunc);
+    journalOut.write(oldJournal.data(), oldJournal.size());
+    journalOut.close();
+
+    StateStore store;
+    ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+    ASSERT_EQ(inputs.size(), 1);
+    ASSERT_EQ(inputs["M_1"].state, 1);
+    ASSERT_EQ(store.getJournalRecordCount(), 0);
+}
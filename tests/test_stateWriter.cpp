@@ -0,0 +1,136 @@
+#include "stateWriter.h"
+
+#include <config_category.h>
+#include <gtest/gtest.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    class StateWriterTest : public testing::Test
+    {
+    protected:
+        std::string directory;
+        std::string path;
+        std::shared_ptr<ConfigOperation> config;
+
+        void SetUp() override
+        {
+            char directoryTemplate[] = "/tmp/spoperators_stateXXXXXX";
+            ASSERT_NE(mkdtemp(directoryTemplate), nullptr);
+            directory = directoryTemplate;
+            path = directory + "/state";
+            config = std::make_shared<ConfigOperation>();
+            config->importExchangedData(QUOTE({
+                "exchanged_data": {
+                    "datapoints" : [
+                        {
+                            "label":"TS-1",
+                            "pivot_id" : "M_OUT",
+                            "pivot_type" : "SpsTyp",
+                            "operations" : [
+                                {
+                                    "operation": "or",
+                                    "input" : [
+                                        "M_1",
+                                        "M_2"
+                                    ]
+                                }
+                            ]
+                        },
+                        {
+                            "label":"TS-2",
+                            "pivot_id" : "M_1",
+                            "pivot_type" : "SpsTyp"
+                        },
+                        {
+                            "label":"TS-3",
+                            "pivot_id" : "M_2",
+                            "pivot_type" : "SpsTyp"
+                        }
+                    ]
+                }
+            }));
+            ASSERT_GE(config->getPivotIndex("M_1"), 0);
+            ASSERT_GE(config->getPivotIndex("M_2"), 0);
+        }
+
+        void TearDown() override
+        {
+            unlink(path.c_str());
+            unlink((path + ".journal").c_str());
+            unlink((path + ".tmp").c_str());
+            rmdir(directory.c_str());
+        }
+
+        static PersistedInput makeInput(uint8_t state, uint64_t timestamp) {
+            PersistedInput input;
+            input.state = state;
+            input.timestamp = timestamp;
+            return input;
+        }
+
+        off_t getJournalSize() const {
+            struct stat journalStat;
+            return stat((path + ".journal").c_str(), &journalStat) == 0 ? journalStat.st_size : -1;
+        }
+    };
+}
+
+TEST_F(StateWriterTest, ChangesFlushedOnClose)
+{
+    std::unordered_map<std::string, PersistedInput> inputs;
+    uint64_t snapshotTime = 0;
+    StateWriter writer;
+    writer.setFlushInterval(3600 * 1000);
+    ASSERT_TRUE(writer.open(path, inputs, snapshotTime));
+    ASSERT_TRUE(writer.isOpen());
+    off_t emptyJournalSize = getJournalSize();
+
+    StateWriter::Changes changes;
+    changes.emplace_back(config->getPivotIndex("M_1"), makeInput(1, 100));
+    changes.emplace_back(config->getPivotIndex("M_2"), makeInput(2, 200));
+    writer.record(config, std::move(changes));
+    ASSERT_EQ(writer.getJournalRecordCount(), 2);
+    // Nothing is written before the end of the flush interval
+    usleep(50000);
+    ASSERT_EQ(getJournalSize(), emptyJournalSize);
+
+    writer.close();
+    ASSERT_FALSE(writer.isOpen());
+    ASSERT_GT(getJournalSize(), emptyJournalSize);
+    StateStore store;
+    ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+    ASSERT_EQ(inputs.size(), 2);
+    ASSERT_EQ(inputs["M_1"].timestamp, 100);
+    ASSERT_EQ(inputs["M_2"].state, 2);
+}
+
+TEST_F(StateWriterTest, SnapshotReplacesJournal)
+{
+    std::unordered_map<std::string, PersistedInput> inputs;
+    uint64_t snapshotTime = 0;
+    StateWriter writer;
+    ASSERT_TRUE(writer.open(path, inputs, snapshotTime));
+
+    StateWriter::Changes changes;
+    changes.emplace_back(config->getPivotIndex("M_1"), makeInput(1, 100));
+    writer.record(config, std::move(changes));
+    std::vector<PersistedInput> snapshotInputs(config->getPivotCount());
+    snapshotInputs[config->getPivotIndex("M_1")] = makeInput(1, 100);
+    writer.snapshot(config, std::move(snapshotInputs));
+    ASSERT_EQ(writer.getJournalRecordCount(), 0);
+    // Changes queued after the snapshot go to the journal it starts
+    changes.clear();
+    changes.emplace_back(config->getPivotIndex("M_2"), makeInput(2, 200));
+    writer.record(config, std::move(changes));
+    writer.close();
+
+    StateStore store;
+    ASSERT_TRUE(store.open(path, inputs, snapshotTime));
+    ASSERT_GT(snapshotTime, 0);
+    ASSERT_EQ(store.getJournalRecordCount(), 1);
+    ASSERT_EQ(inputs.size(), 2);
+    ASSERT_EQ(inputs["M_1"].state, 1);
+    ASSERT_EQ(inputs["M_2"].timestamp, 200);
+}
@@ -0,0 +1,55 @@
+#include "timestampMaxima.h"
+
+#include <gtest/gtest.h>
+
+TEST(TimestampMaximaTest, RunningMaxima)
+{
+    TimestampMaxima maxima;
+    maxima.reset(2);
+    ASSERT_EQ(maxima.getMaximum(0, TimestampMaxima::AllInputs), 0);
+
+    maxima.add(0, PointState::StateOff, 10);
+    maxima.add(0, PointState::StateOff, 20);
+    maxima.add(1, PointState::StateOn, 5);
+    ASSERT_EQ(maxima.getMaximum(0, PointState::StateOff), 20);
+    ASSERT_EQ(maxima.getMaximum(0, TimestampMaxima::AllInputs), 20);
+    ASSERT_EQ(maxima.getMaximum(0, PointState::StateOn), 0);
+    ASSERT_EQ(maxima.getMaximum(1, TimestampMaxima::AllInputs), 5);
+
+    // Newer timestamps in the same state only raise the maxima
+    maxima.move(0, PointState::StateOff, 10, PointState::StateOff, 30);
+    ASSERT_FALSE(maxima.isStale(0, PointState::StateOff));
+    ASSERT_EQ(maxima.getMaximum(0, PointState::StateOff), 30);
+
+    // The input holding the maximum of a state leaves it: the state must be recomputed, not the other groups
+    maxima.move(0, PointState::StateOff, 30, PointState::StateOn, 40);
+    ASSERT_TRUE(maxima.isStale(0, PointState::StateOff));
+    ASSERT_FALSE(maxima.isStale(0, PointState::StateOn));
+    ASSERT_FALSE(maxima.isStale(0, TimestampMaxima::AllInputs));
+    ASSERT_EQ(maxima.getMaximum(0, PointState::StateOn), 40);
+    ASSERT_EQ(maxima.getMaximum(0, TimestampMaxima::AllInputs), 40);
+    maxima.setMaximum(0, PointState::StateOff, 20);
+    ASSERT_FALSE(maxima.isStale(0, PointState::StateOff));
+
+    // Leaving a state without holding its maximum keeps it valid
+    maxima.move(0, PointState::StateOff, 20, PointState::StateOn, 50);
+    ASSERT_TRUE(maxima.isStale(0, PointState::StateOff));
+    maxima.setMaximum(0, PointState::StateOff, 0);
+    maxima.add(0, PointState::StateOff, 15);
+    maxima.move(0, PointState::StateOn, 40, PointState::StateOn, 45);
+    ASSERT_FALSE(maxima.isStale(0, PointState::StateOn));
+    ASSERT_EQ(maxima.getMaximum(0, PointState::StateOn), 50);
+
+    // Going back in time from the maximum makes it stale
+    maxima.move(0, PointState::StateOn, 50, PointState::StateOn, 1);
+    ASSERT_TRUE(maxima.isStale(0, PointState::StateOn));
+    ASSERT_TRUE(maxima.isStale(0, TimestampMaxima::AllInputs));
+
+    TimestampMaxima other;
+    other.reset(1);
+    other.copyOperation(0, maxima, 0);
+    ASSERT_TRUE(other.isStale(0, TimestampMaxima::AllInputs));
+    ASSERT_EQ(other.getMaximum(0, PointState::StateOff), 15);
+    other.swap(maxima);
+    ASSERT_EQ(other.getMaximum(1, TimestampMaxima::AllInputs), 5);
+}
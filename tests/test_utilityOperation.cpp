@@ -29,6 +29,12 @@ TEST(OperationUtilityTest, Split)
     ASSERT_EQ(UtilityOperation::split("TEST--TORTOISE", '-'), out2);
 }
 
+TEST(OperationUtilityTest, EscapeJson)
+{
+    ASSERT_EQ(UtilityOperation::escapeJson("M_2367_3_15_4"), "M_2367_3_15_4");
+    ASSERT_EQ(UtilityOperation::escapeJson("a\"b\\c\nd\x01"), "a\\\"b\\\\c\\nd\\u0001");
+}
+
 TEST(OperationUtilityTest, Logs)
 {
     std::string text("This message is at level %s");
@@ -37,4 +43,41 @@ TEST(OperationUtilityTest, Logs)
     ASSERT_NO_THROW(UtilityOperation::log_warn(text.c_str(), "warning"));
     ASSERT_NO_THROW(UtilityOperation::log_error(text.c_str(), "error"));
     ASSERT_NO_THROW(UtilityOperation::log_fatal(text.c_str(), "fatal"));
-}
\ No newline at end of file
+}
+
+TEST(OperationUtilityTest, LogMacros)
+{
+    int evaluations = 0;
+    auto argument = [&evaluations]() {
+        evaluations++;
+        return "argument";
+    };
+    std::string minLevel = Logger::getLogger()->getMinLevel();
+
+    Logger::getLogger()->setMinLevel("debug");
+    ASSERT_TRUE(UtilityOperation::isLogLevelEnabled(UtilityOperation::LogLevel::Debug));
+    ASSERT_NO_THROW(SPOPERATORS_LOG_DEBUG("This message is at level debug with %s", argument()));
+#ifdef SPOPERATORS_DISABLE_DEBUG_LOG
+    ASSERT_EQ(evaluations, 0);
+#else
+    ASSERT_EQ(evaluations, 1);
+#endif
+
+    // The arguments of a message below the minimum level of the logger are not evaluated
+    evaluations = 0;
+    Logger::getLogger()->setMinLevel("info");
+    bool debugEnabled = UtilityOperation::isLogLevelEnabled(UtilityOperation::LogLevel::Debug);
+    bool infoEnabled = UtilityOperation::isLogLevelEnabled(UtilityOperation::LogLevel::Info);
+    Logger::getLogger()->setMinLevel("warning");
+    bool warningDebugEnabled = UtilityOperation::isLogLevelEnabled(UtilityOperation::LogLevel::Debug);
+    bool warningInfoEnabled = UtilityOperation::isLogLevelEnabled(UtilityOperation::LogLevel::Info);
+    bool warningErrorEnabled = UtilityOperation::isLogLevelEnabled(UtilityOperation::LogLevel::Error);
+    SPOPERATORS_LOG_DEBUG("This message is at level debug with %s", argument());
+    Logger::getLogger()->setMinLevel(minLevel);
+    ASSERT_FALSE(debugEnabled);
+    ASSERT_TRUE(infoEnabled);
+    ASSERT_FALSE(warningDebugEnabled);
+    ASSERT_FALSE(warningInfoEnabled);
+    ASSERT_TRUE(warningErrorEnabled);
+    ASSERT_EQ(evaluations, 0);
+}
@@ -0,0 +1,60 @@
+#include "workerPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(WorkerPoolTest, RunTasks)
+{
+    WorkerPool pool(4);
+    ASSERT_EQ(pool.getWorkerCount(), 4);
+    for (int batch = 0 ; batch < 20 ; batch++) {
+        // Every task runs exactly once, on one of the workers
+        std::vector<std::atomic<int>> runs(100 + batch);
+        for (auto& run : runs) {
+            run = 0;
+        }
+        std::atomic<bool> validWorkers(true);
+        pool.run(runs.size(), [&](std::size_t taskIndex, std::size_t workerIndex) {
+            runs[taskIndex]++;
+            if (workerIndex >= 4) {
+                validWorkers = false;
+            }
+        });
+        ASSERT_TRUE(validWorkers);
+        for (std::size_t i = 0 ; i < runs.size() ; i++) {
+            ASSERT_EQ(runs[i], 1) << "batch " << batch << " task " << i;
+        }
+    }
+    pool.run(0, [](std::size_t, std::size_t) { FAIL(); });
+}
+
+TEST(WorkerPoolTest, TaskException)
+{
+    WorkerPool pool(3);
+    std::atomic<int> runCount(0);
+    ASSERT_THROW(pool.run(10, [&](std::size_t taskIndex, std::size_t) {
+        runCount++;
+        if (taskIndex == 5) {
+            throw std::runtime_error("task failed");
+        }
+    }), std::runtime_error);
+    // The other tasks of the batch still run, and the pool can be used again
+    ASSERT_EQ(runCount, 10);
+    runCount = 0;
+    pool.run(10, [&](std::size_t, std::size_t) { runCount++; });
+    ASSERT_EQ(runCount, 10);
+}
+
+TEST(WorkerPoolTest, SingleWorker)
+{
+    WorkerPool pool(1);
+    std::vector<std::size_t> order;
+    pool.run(5, [&](std::size_t taskIndex, std::size_t workerIndex) {
+        ASSERT_EQ(workerIndex, 0);
+        order.push_back(taskIndex);
+    });
+    ASSERT_EQ(order, std::vector<std::size_t>({0, 1, 2, 3, 4}));
+}
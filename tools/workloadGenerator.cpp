@@ -0,0 +1,146 @@
+/*
+ * Synthetic exchanged_data configurations and PIVOT readings
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "workloadGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+
+using namespace std;
+
+string WorkloadGenerator::pivotId(size_t index) {
+    return "M_" + to_string(index);
+}
+
+string WorkloadGenerator::label(size_t index) {
+    return "TS-" + to_string(index);
+}
+
+vector<WorkloadGenerator::OperationSpec> WorkloadGenerator::pairwiseOperations(size_t outputCount) {
+    vector<OperationSpec> operations(outputCount);
+    for (size_t i = 0 ; i < outputCount ; i++) {
+        operations[i].output = i;
+        operations[i].inputs = {outputCount + 2 * i, outputCount + 2 * i + 1};
+    }
+    return operations;
+}
+
+vector<WorkloadGenerator::OperationSpec> WorkloadGenerator::fanOutOperations(size_t fanOut) {
+    vector<OperationSpec> operations(fanOut);
+    for (size_t i = 0 ; i < fanOut ; i++) {
+        operations[i].output = i + 1;
+        operations[i].inputs = {0, fanOut + i + 1};
+    }
+    return operations;
+}
+
+vector<WorkloadGenerator::OperationSpec> WorkloadGenerator::wideOperation(size_t width) {
+    vector<OperationSpec> operations(1);
+    operations[0].output = 0;
+    for (size_t i = 1 ; i <= width ; i++) {
+        operations[0].inputs.push_back(i);
+    }
+    return operations;
+}
+
+vector<WorkloadGenerator::OperationSpec> WorkloadGenerator::randomOperations(size_t pointCount, size_t outputCount, size_t fanInMin,
+                                                                             size_t fanInMax, double fanOutSkew, unsigned int seed) {
+    vector<OperationSpec> operations;
+    if (outputCount >= pointCount || fanInMin == 0 || fanInMin > fanInMax) {
+        return operations;
+    }
+    size_t inputCount = pointCount - outputCount;
+    fanInMax = min(fanInMax, inputCount);
+    fanInMin = min(fanInMin, fanInMax);
+
+    mt19937 generator(seed);
+    vector<double> weights(inputCount);
+    for (size_t rank = 0 ; rank < inputCount ; rank++) {
+        weights[rank] = 1.0 / pow(static_cast<double>(rank + 1), fanOutSkew);
+    }
+    discrete_distribution<size_t> pickInput(weights.begin(), weights.end());
+    uniform_int_distribution<size_t> pickFanIn(fanInMin, fanInMax);
+
+    operations.resize(outputCount);
+    for (size_t i = 0 ; i < outputCount ; i++) {
+        operations[i].output = i;
+        size_t fanIn = pickFanIn(generator);
+        set<size_t> inputs;
+        // Skewed picks may keep returning the same inputs, fall back to a linear fill after too many attempts
+        for (size_t attempt = 0 ; inputs.size() < fanIn && attempt < 16 * fanIn ; attempt++) {
+            inputs.insert(outputCount + pickInput(generator));
+        }
+        for (size_t input = outputCount ; inputs.size() < fanIn ; input++) {
+            inputs.insert(input);
+        }
+        operations[i].inputs.assign(inputs.begin(), inputs.end());
+    }
+    return operations;
+}
+
+size_t WorkloadGenerator::pointCount(const vector<OperationSpec>& operations) {
+    size_t count = 0;
+    for (const auto& operation : operations) {
+        count = max(count, operation.output + 1);
+        for (size_t input : operation.inputs) {
+            count = max(count, input + 1);
+        }
+    }
+    return count;
+}
+
+string WorkloadGenerator::generateExchangedData(size_t pointCount, const vector<OperationSpec>& operations, const string& pivotType) {
+    map<size_t, vector<const OperationSpec*>> operationsByOutput;
+    for (const auto& operation : operations) {
+        operationsByOutput[operation.output].push_back(&operation);
+    }
+
+    string json = "{\"exchanged_data\":{\"name\":\"BENCH\",\"version\":\"1.0\",\"datapoints\":[";
+    for (size_t i = 0 ; i < pointCount ; i++) {
+        if (i > 0) {
+            json += ",";
+        }
+        json += "{\"label\":\"" + label(i) + "\",\"pivot_id\":\"" + pivotId(i) + "\",\"pivot_type\":\"" + pivotType + "\"";
+        auto it = operationsByOutput.find(i);
+        if (it != operationsByOutput.end()) {
+            json += ",\"operations\":[";
+            for (size_t j = 0 ; j < it->second.size() ; j++) {
+                if (j > 0) {
+                    json += ",";
+                }
+                json += "{\"operation\":\"or\",\"input\":[";
+                const auto& inputs = it->second[j]->inputs;
+                for (size_t k = 0 ; k < inputs.size() ; k++) {
+                    if (k > 0) {
+                        json += ",";
+                    }
+                    json += "\"" + pivotId(inputs[k]) + "\"";
+                }
+                json += "]}";
+            }
+            json += "]";
+        }
+        json += ",\"protocols\":[{\"name\":\"IEC104\",\"typeid\":\"M_SP_TB_1\",\"address\":\"" + to_string(i) + "\"}]}";
+    }
+    json += "]}}";
+    return json;
+}
+
+string WorkloadGenerator::generatePluginConfig(const string& exchangedData) {
+    return "{\"enable\":{\"value\":\"true\"},\"exchanged_data\":{\"value\":" + exchangedData + "}}";
+}
+
+string WorkloadGenerator::generatePivotJson(const string& pivotType, const string& pivotId, int value, long seconds, long fraction) {
+    string stVal = (pivotType == "DpsTyp") ? (value ? "\"on\"" : "\"off\"") : to_string(value);
+    return "{\"PIVOT\":{\"GTIS\":{\"" + pivotType + "\":{\"q\":{\"Source\":\"process\",\"Validity\":\"good\"},"
+           "\"t\":{\"FractionOfSecond\":" + to_string(fraction) + ",\"SecondSinceEpoch\":" + to_string(seconds) + "},"
+           "\"stVal\":" + stVal + "},\"Identifier\":\"" + pivotId + "\"}}}";
+}
@@ -0,0 +1,104 @@
+#ifndef TOOLS_WORKLOAD_GENERATOR_H_
+#define TOOLS_WORKLOAD_GENERATOR_H_
+
+/*
+ * Synthetic exchanged_data configurations and PIVOT readings
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace WorkloadGenerator {
+    /**
+     * "or" operation between datapoints identified by their index
+     */
+    struct OperationSpec {
+        std::size_t output = 0;
+        std::vector<std::size_t> inputs;
+    };
+
+    /**
+     * Pivot ID of the datapoint with the given index
+     * @param index : Index of the datapoint
+     * @return The pivot ID
+    */
+    std::string pivotId(std::size_t index);
+    /**
+     * Label (asset name) of the datapoint with the given index
+     * @param index : Index of the datapoint
+     * @return The label
+    */
+    std::string label(std::size_t index);
+
+    /**
+     * Outputs 0 to outputCount-1, each one being the "or" of its own pair of inputs placed after all outputs
+     * @param outputCount : Number of outputs
+     * @return The operations, using 3*outputCount datapoints
+    */
+    std::vector<OperationSpec> pairwiseOperations(std::size_t outputCount);
+    /**
+     * Outputs 1 to fanOut, each one being the "or" of input 0 and of one input of its own
+     * @param fanOut : Number of outputs of input 0
+     * @return The operations, using 2*fanOut+1 datapoints
+    */
+    std::vector<OperationSpec> fanOutOperations(std::size_t fanOut);
+    /**
+     * Output 0 being the "or" of inputs 1 to width
+     * @param width : Number of inputs of the operation
+     * @return The operations, using width+1 datapoints
+    */
+    std::vector<OperationSpec> wideOperation(std::size_t width);
+    /**
+     * Random operations similar to a real substation configuration: outputs are the first outputCount datapoints,
+     * each one being the "or" of a random number of the other datapoints.
+     * Inputs are picked following a Zipf law of exponent fanOutSkew, so that a few inputs feed many outputs (0 for a uniform pick)
+     * @param pointCount : Number of datapoints
+     * @param outputCount : Number of outputs, lower than pointCount
+     * @param fanInMin : Minimum number of inputs of an operation
+     * @param fanInMax : Maximum number of inputs of an operation
+     * @param fanOutSkew : Zipf exponent used to pick the inputs
+     * @param seed : Seed of the random generator
+     * @return The operations
+    */
+    std::vector<OperationSpec> randomOperations(std::size_t pointCount, std::size_t outputCount, std::size_t fanInMin,
+                                                std::size_t fanInMax, double fanOutSkew, unsigned int seed);
+    /**
+     * Number of datapoints referenced by a list of operations
+     * @param operations : Operations to scan
+     * @return The highest datapoint index used plus one
+    */
+    std::size_t pointCount(const std::vector<OperationSpec>& operations);
+
+    /**
+     * Generate the exchanged_data JSON describing pointCount datapoints and the given operations
+     * @param pointCount : Number of datapoints to declare
+     * @param operations : Operations to configure on the datapoints
+     * @param pivotType : Pivot type of all datapoints (SpsTyp or DpsTyp)
+     * @return The exchanged_data JSON
+    */
+    std::string generateExchangedData(std::size_t pointCount, const std::vector<OperationSpec>& operations, const std::string& pivotType);
+    /**
+     * Generate a complete filter configuration, enabled, using the given exchanged_data
+     * @param exchangedData : exchanged_data JSON
+     * @return The filter configuration JSON, as given to plugin_reconfigure
+    */
+    std::string generatePluginConfig(const std::string& exchangedData);
+    /**
+     * Generate the JSON of a PIVOT datapoint
+     * @param pivotType : Pivot type (SpsTyp or DpsTyp)
+     * @param pivotId : Pivot ID written in GTIS.Identifier
+     * @param value : Value of the status point (0/1, converted to "off"/"on" for DpsTyp)
+     * @param seconds : Timestamp seconds since epoch
+     * @param fraction : Timestamp fraction of second
+     * @return The JSON of the PIVOT datapoint
+    */
+    std::string generatePivotJson(const std::string& pivotType, const std::string& pivotId, int value,
+                                  long seconds, long fraction);
+}
+
+#endif  // TOOLS_WORKLOAD_GENERATOR_H_
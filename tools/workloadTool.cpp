@@ -0,0 +1,293 @@
+/*
+ * Generation of synthetic workloads and replay of recorded readings through the plugin
+ *
+ * Copyright (c) 2026, RTE (https://www.rte-france.com)
+ *
+ * Released under the Apache 2.0 Licence
+ *
+ */
+#include "workloadGenerator.h"
+
+#include <filter.h>
+#include <reading_set.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+    PLUGIN_HANDLE plugin_init(ConfigCategory* config,
+                          OUTPUT_HANDLE *outHandle,
+                          OUTPUT_STREAM output);
+
+    void plugin_shutdown(PLUGIN_HANDLE handle);
+    void plugin_reconfigure(PLUGIN_HANDLE handle, const std::string& newConfig);
+    void plugin_ingest(PLUGIN_HANDLE handle, READINGSET *readingSet);
+};
+
+using namespace std;
+
+namespace {
+    const char *usage =
+        "Usage:\n"
+        "  spoperators_workload generate --config-out FILE --readings-out FILE [options]\n"
+        "      --points N          Number of datapoints (default 10000)\n"
+        "      --outputs M         Number of datapoints computed by an operation (default 1000)\n"
+        "      --fan-in MIN:MAX    Number of inputs of each operation (default 2:4)\n"
+        "      --fan-out-skew S    Zipf exponent used to pick the inputs, 0 for uniform (default 1.0)\n"
+        "      --type TYPE         SpsTyp or DpsTyp (default SpsTyp)\n"
+        "      --readings R        Number of spontaneous readings (default 100000)\n"
+        "      --rate R            Spontaneous readings per second (default 1000)\n"
+        "      --gi-period SEC     Period of general interrogations, every point is sent at once, 0 to disable (default 60)\n"
+        "      --seed S            Seed of the random generator (default 1)\n"
+        "  spoperators_workload replay --config FILE --readings FILE [options]\n"
+        "      --speed MODE        max or wallclock (default max)\n"
+        "      --max-batch N       Maximum number of readings per reading set (default 1000)\n"
+        "\n"
+        "Readings files contain one reading per line: <timestamp in us> TAB <asset name> TAB <JSON of the reading datapoints>\n"
+        "Consecutive readings with the same timestamp are ingested in the same reading set.\n";
+
+    /**
+     * Command line options, as a map of option name to value
+     */
+    class Options {
+    public:
+        bool parse(int argc, char **argv, int first) {
+            for (int i = first ; i < argc ; i += 2) {
+                string name = argv[i];
+                if (name.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+                    cerr << "Invalid option " << name << endl;
+                    return false;
+                }
+                m_values[name.substr(2)] = argv[i + 1];
+            }
+            return true;
+        }
+
+        string get(const string& name, const string& defaultValue) const {
+            auto it = m_values.find(name);
+            return it == m_values.end() ? defaultValue : it->second;
+        }
+
+        size_t getSize(const string& name, size_t defaultValue) const {
+            auto it = m_values.find(name);
+            return it == m_values.end() ? defaultValue : static_cast<size_t>(strtoull(it->second.c_str(), nullptr, 10));
+        }
+
+        double getDouble(const string& name, double defaultValue) const {
+            auto it = m_values.find(name);
+            return it == m_values.end() ? defaultValue : strtod(it->second.c_str(), nullptr);
+        }
+
+    private:
+        map<string, string> m_values;
+    };
+
+    /**
+     * Generate an exchanged_data configuration and a stream of readings matching it
+     */
+    int generate(const Options& options) {
+        string configOut = options.get("config-out", "");
+        string readingsOut = options.get("readings-out", "");
+        if (configOut.empty() || readingsOut.empty()) {
+            cerr << usage;
+            return 1;
+        }
+        size_t pointCount = options.getSize("points", 10000);
+        size_t outputCount = options.getSize("outputs", 1000);
+        string fanIn = options.get("fan-in", "2:4");
+        size_t separator = fanIn.find(':');
+        size_t fanInMin = strtoull(fanIn.substr(0, separator).c_str(), nullptr, 10);
+        size_t fanInMax = separator == string::npos ? fanInMin : strtoull(fanIn.substr(separator + 1).c_str(), nullptr, 10);
+        double fanOutSkew = options.getDouble("fan-out-skew", 1.0);
+        string pivotType = options.get("type", "SpsTyp");
+        size_t readingCount = options.getSize("readings", 100000);
+        double rate = options.getDouble("rate", 1000);
+        double giPeriod = options.getDouble("gi-period", 60);
+        unsigned int seed = static_cast<unsigned int>(options.getSize("seed", 1));
+        if (outputCount >= pointCount || fanInMin == 0 || fanInMin > fanInMax || rate <= 0) {
+            cerr << "Invalid workload parameters" << endl;
+            return 1;
+        }
+
+        auto operations = WorkloadGenerator::randomOperations(pointCount, outputCount, fanInMin, fanInMax, fanOutSkew, seed);
+        ofstream config(configOut);
+        config << WorkloadGenerator::generateExchangedData(pointCount, operations, pivotType) << "\n";
+
+        // Spontaneous readings flip the value of a random point, general interrogations send the value of every point
+        ofstream readings(readingsOut);
+        mt19937 generator(seed);
+        uniform_int_distribution<size_t> pickPoint(0, pointCount - 1);
+        vector<int> values(pointCount, 0);
+        const long startSeconds = 1700000000;
+        const uint64_t startUs = static_cast<uint64_t>(startSeconds) * 1000000;
+        const uint64_t giPeriodUs = static_cast<uint64_t>(giPeriod * 1000000);
+        uint64_t nextGiUs = 0;
+        auto writeReading = [&](uint64_t timestampUs, size_t point) {
+            uint64_t absoluteUs = startUs + timestampUs;
+            readings << absoluteUs << "\t" << WorkloadGenerator::label(point) << "\t"
+                     << WorkloadGenerator::generatePivotJson(pivotType, WorkloadGenerator::pivotId(point), values[point],
+                                                             static_cast<long>(absoluteUs / 1000000), static_cast<long>((absoluteUs % 1000000) * 16777216 / 1000000))
+                     << "\n";
+        };
+        for (size_t i = 0 ; i < readingCount ; i++) {
+            uint64_t timestampUs = static_cast<uint64_t>(i * 1000000.0 / rate);
+            if (giPeriodUs > 0 && timestampUs >= nextGiUs) {
+                for (size_t point = 0 ; point < pointCount ; point++) {
+                    writeReading(nextGiUs, point);
+                }
+                nextGiUs += giPeriodUs;
+            }
+            size_t point = pickPoint(generator);
+            values[point] = 1 - values[point];
+            writeReading(timestampUs, point);
+        }
+        return 0;
+    }
+
+    uint64_t outputReadingCount = 0;
+
+    void countOutput(OUTPUT_HANDLE *handle, READINGSET *readingSet) {
+        outputReadingCount += readingSet->getAllReadings().size();
+    }
+
+    /**
+     * Value at the given percentile of sorted values (nearest rank)
+     */
+    double percentile(const vector<double>& sortedValues, double percent) {
+        if (sortedValues.empty()) {
+            return 0;
+        }
+        size_t rank = static_cast<size_t>(percent / 100.0 * sortedValues.size());
+        return sortedValues[min(rank, sortedValues.size() - 1)];
+    }
+
+    /**
+     * Replay a readings file through plugin_ingest and report latency and throughput
+     */
+    int replay(const Options& options) {
+        string configFile = options.get("config", "");
+        string readingsFile = options.get("readings", "");
+        if (configFile.empty() || readingsFile.empty()) {
+            cerr << usage;
+            return 1;
+        }
+        string speed = options.get("speed", "max");
+        bool wallClock = (speed == "wallclock");
+        if (!wallClock && speed != "max") {
+            cerr << "Invalid speed " << speed << endl;
+            return 1;
+        }
+        size_t maxBatch = max<size_t>(1, options.getSize("max-batch", 1000));
+
+        ifstream configStream(configFile);
+        stringstream exchangedData;
+        exchangedData << configStream.rdbuf();
+        ifstream readings(readingsFile);
+        if (!configStream || !readings) {
+            cerr << "Unable to open input files" << endl;
+            return 1;
+        }
+
+        PLUGIN_HANDLE handle = plugin_init(nullptr, nullptr, countOutput);
+        plugin_reconfigure(handle, WorkloadGenerator::generatePluginConfig(exchangedData.str()));
+
+        DatapointValue parserValue("");
+        Datapoint parser("parser", parserValue);
+        vector<double> batchLatenciesUs;
+        uint64_t inputReadingCount = 0;
+        double ingestSeconds = 0;
+        auto replayStart = chrono::steady_clock::now();
+        uint64_t firstTimestampUs = 0;
+        bool first = true;
+
+        string line;
+        bool pending = getline(readings, line).good();
+        while (pending) {
+            // Build the next reading set from consecutive lines with the same timestamp
+            vector<Reading*> *batch = new vector<Reading*>;
+            uint64_t batchTimestampUs = 0;
+            while (pending && batch->size() < maxBatch) {
+                size_t tab1 = line.find('\t');
+                size_t tab2 = tab1 == string::npos ? string::npos : line.find('\t', tab1 + 1);
+                if (tab2 == string::npos) {
+                    pending = getline(readings, line).good();
+                    continue;
+                }
+                uint64_t timestampUs = strtoull(line.substr(0, tab1).c_str(), nullptr, 10);
+                if (!batch->empty() && timestampUs != batchTimestampUs) {
+                    break;
+                }
+                batchTimestampUs = timestampUs;
+                vector<Datapoint*> *datapoints = parser.parseJson(line.substr(tab2 + 1));
+                batch->push_back(new Reading(line.substr(tab1 + 1, tab2 - tab1 - 1), *datapoints));
+                delete datapoints;
+                pending = getline(readings, line).good();
+            }
+            if (batch->empty()) {
+                delete batch;
+                continue;
+            }
+            unique_ptr<ReadingSet> readingSet(new ReadingSet(batch));
+            inputReadingCount += batch->size();
+            delete batch;
+
+            if (first) {
+                firstTimestampUs = batchTimestampUs;
+                first = false;
+            }
+            if (wallClock) {
+                this_thread::sleep_until(replayStart + chrono::microseconds(batchTimestampUs - firstTimestampUs));
+            }
+
+            auto ingestStart = chrono::steady_clock::now();
+            plugin_ingest(handle, readingSet.get());
+            chrono::duration<double> ingestDuration = chrono::steady_clock::now() - ingestStart;
+            batchLatenciesUs.push_back(ingestDuration.count() * 1e6);
+            ingestSeconds += ingestDuration.count();
+        }
+        chrono::duration<double> replayDuration = chrono::steady_clock::now() - replayStart;
+        plugin_shutdown(handle);
+
+        sort(batchLatenciesUs.begin(), batchLatenciesUs.end());
+        printf("Reading sets: %zu, input readings: %llu, output readings: %llu\n", batchLatenciesUs.size(),
+               static_cast<unsigned long long>(inputReadingCount), static_cast<unsigned long long>(outputReadingCount));
+        printf("Replay duration: %.3f s, time spent in plugin_ingest: %.3f s\n", replayDuration.count(), ingestSeconds);
+        printf("Throughput: %.0f readings/s\n", ingestSeconds > 0 ? inputReadingCount / ingestSeconds : 0.0);
+        printf("plugin_ingest latency (us): p50 %.1f, p90 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+               percentile(batchLatenciesUs, 50), percentile(batchLatenciesUs, 90), percentile(batchLatenciesUs, 99),
+               percentile(batchLatenciesUs, 99.9), batchLatenciesUs.empty() ? 0.0 : batchLatenciesUs.back());
+        return 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        cerr << usage;
+        return 1;
+    }
+    string command = argv[1];
+    Options options;
+    if (!options.parse(argc, argv, 2)) {
+        cerr << usage;
+        return 1;
+    }
+    if (command == "generate") {
+        return generate(options);
+    }
+    if (command == "replay") {
+        return replay(options);
+    }
+    cerr << usage;
+    return 1;
+}